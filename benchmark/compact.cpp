@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+#include "inc/cxx/compact.hpp"
+
+static constexpr std::int64_t const elements = 10'000'000;
+
+template <typename Node>
+static typename Node::array const& numbers()
+{
+  static auto const ret = [] {
+    typename Node::array ret;
+    ret.reserve(elements);
+    for (std::int64_t i = 0; i < elements; ++i)
+      if (i % 2 == 0)
+        ret.emplace_back(i);
+      else
+        ret.emplace_back(static_cast<double>(i) / 2);
+    return ret;
+  }();
+  return ret;
+}
+
+template <typename Node>
+static void memory(benchmark::State& state, typename Node::array const& x)
+{
+  state.counters["node_size"] = sizeof(Node);
+  state.counters["memory"] = benchmark::Counter(static_cast<double>(x.capacity() * sizeof(Node)),
+                                                benchmark::Counter::kDefaults,
+                                                benchmark::Counter::kIs1024);
+}
+
+template <typename Node>
+static void cxx_build_numbers(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    typename Node::array x;
+    x.reserve(elements);
+    for (std::int64_t i = 0; i < elements; ++i) x.emplace_back(i);
+    benchmark::DoNotOptimize(x.data());
+  }
+  state.SetItemsProcessed(state.iterations() * elements);
+}
+
+template <typename Node>
+static void cxx_traverse_numbers(benchmark::State& state)
+{
+  auto const& array = numbers<Node>();
+  auto const sum = cxx::overload{[](std::int64_t x) { return static_cast<double>(x); },
+                                 [](double x) { return x; },
+                                 [](auto const&) { return 0.0; }};
+  for (auto _ : state)
+  {
+    double total = 0;
+    for (auto const& item : array) total += cxx::visit(sum, item);
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * elements);
+  memory<Node>(state, array);
+}
+
+BENCHMARK_TEMPLATE(cxx_build_numbers, cxx::json)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(cxx_build_numbers, cxx::compact)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(cxx_traverse_numbers, cxx::json)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(cxx_traverse_numbers, cxx::compact)->Unit(benchmark::kMillisecond);
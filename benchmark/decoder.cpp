@@ -1,11 +1,38 @@
 #include <benchmark/benchmark.h>
 #include "inc/cxx/cbor.hpp"
 #include "inc/cxx/msgpack.hpp"
+#include "inc/cxx/pool.hpp"
 #include "test/utils.hpp"
+#include <map>
+#include <memory_resource>
 
 using namespace cxx::literals;
 using namespace test::literals;
 
+struct text {
+  static std::string encode(cxx::json const& json) { return cxx::to_string(json); }
+  static cxx::json decode(std::string const& str) { return cxx::parse(str); }
+};
+
+static cxx::json document()
+{
+  cxx::json::array records;
+  for (std::int64_t i = 0; i < 256; ++i)
+  {
+    records.push_back({
+        // clang-format off
+        "id"_key >> i,
+        "name"_key >> "lorem ipsum dolor sit amet",
+        "score"_key >> 0.25 * static_cast<double>(i),
+        "active"_key >> (i % 2 == 0),
+        "tags"_key >> cxx::json{"consectetur", "adipiscing", "elit"},
+        "position"_key >> cxx::json{"x"_key >> -i, "y"_key >> i * 1000, "z"_key >> cxx::json::null}
+        // clang-format on
+    });
+  }
+  return records;
+}
+
 template <typename Codec>
 static void cxx_decode_positive_integers(benchmark::State& state)
 {
@@ -69,6 +96,183 @@ static void cxx_decode_double(benchmark::State& state)
   for (auto _ : state) benchmark::DoNotOptimize(Codec::decode(bytes));
 }
 
+template <typename Codec>
+static void cxx_decode_document(benchmark::State& state)
+{
+  auto const bytes = Codec::encode(document());
+  for (auto _ : state) benchmark::DoNotOptimize(Codec::decode(bytes));
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * std::size(bytes)));
+}
+
+template <typename Codec>
+static void cxx_decode_document_pmr(benchmark::State& state)
+{
+  auto const bytes = Codec::encode(document());
+  std::vector<std::byte> buffer(1 << 20);
+  auto* const upstream = std::pmr::null_memory_resource();
+  for (auto _ : state)
+  {
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), std::size(buffer), upstream);
+    benchmark::DoNotOptimize(Codec::decode(bytes, &arena));
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * std::size(bytes)));
+}
+
+template <typename Codec>
+static void cxx_decode_document_pool(benchmark::State& state)
+{
+  auto const bytes = Codec::encode(document());
+  auto& pool = cxx::pool::local();
+  for (auto _ : state) benchmark::DoNotOptimize(Codec::decode(bytes, &pool));
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * std::size(bytes)));
+  state.counters["hits"] = static_cast<double>(pool.hits());
+  state.counters["misses"] = static_cast<double>(pool.misses());
+}
+
+template <typename Codec>
+static void cxx_decode_document_into(benchmark::State& state)
+{
+  auto const bytes = Codec::encode(document());
+  cxx::json target;
+  for (auto _ : state)
+  {
+    Codec::decode_into(bytes, cxx::by_ref(target));
+    benchmark::DoNotOptimize(target);
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * std::size(bytes)));
+}
+
+static std::vector<cxx::json::byte_view> segments(cxx::json::byte_stream const& bytes)
+{
+  std::vector<cxx::json::byte_view> ret;
+  for (std::size_t i = 0; i < std::size(bytes); i += 0x1000)
+    ret.emplace_back(bytes.data() + i, std::min<std::size_t>(0x1000, std::size(bytes) - i));
+  return ret;
+}
+
+template <typename Codec>
+static void cxx_decode_document_concat(benchmark::State& state)
+{
+  auto const bytes = Codec::encode(document());
+  auto const input = segments(bytes);
+  for (auto _ : state)
+  {
+    cxx::json::byte_stream whole;
+    for (auto const& x : input) whole.insert(std::end(whole), std::begin(x), std::end(x));
+    benchmark::DoNotOptimize(Codec::decode(whole));
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * std::size(bytes)));
+}
+
+template <typename Codec>
+static void cxx_decode_document_segments(benchmark::State& state)
+{
+  auto const bytes = Codec::encode(document());
+  auto const input = segments(bytes);
+  for (auto _ : state) benchmark::DoNotOptimize(Codec::decode(input));
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * std::size(bytes)));
+}
+
+template <typename Codec>
+static void cxx_decode_document_arena(benchmark::State& state)
+{
+  auto const bytes = Codec::encode(document());
+  cxx::arena arena;
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(&Codec::decode(bytes, arena));
+    arena.reset();
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * std::size(bytes)));
+}
+
+template <typename Codec>
+static void cxx_decode_dictionary_arena(benchmark::State& state)
+{
+  auto const bytes = Codec::encode({"lorem"_key >> "ipsum", "dolor"_key >> 42});
+  cxx::arena arena;
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(&Codec::decode(bytes, arena));
+    arena.reset();
+  }
+}
+
+template <typename Codec>
+static void cxx_decode_document_tape(benchmark::State& state)
+{
+  auto const bytes = Codec::encode(document());
+  for (auto _ : state) benchmark::DoNotOptimize(Codec::decode_tape(bytes));
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * std::size(bytes)));
+}
+
+template <typename Codec>
+static void cxx_decode_document_view(benchmark::State& state)
+{
+  auto const bytes = Codec::encode(document());
+  for (auto _ : state) benchmark::DoNotOptimize(Codec::decode_view(bytes));
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * std::size(bytes)));
+}
+
+static cxx::json envelope()
+{
+  return {"records"_key >> document(), "id"_key >> 42, "kind"_key >> "update"};
+}
+
+template <typename Codec>
+static void cxx_read_envelope(benchmark::State& state)
+{
+  auto const bytes = Codec::encode(envelope());
+  for (auto _ : state)
+  {
+    auto const json = Codec::decode(bytes);
+    benchmark::DoNotOptimize(cxx::get<std::int64_t>(json["id"]));
+    benchmark::DoNotOptimize(cxx::get<std::string>(json["kind"]).data());
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * std::size(bytes)));
+}
+
+template <typename Codec>
+static void cxx_read_envelope_lazy(benchmark::State& state)
+{
+  auto const bytes = Codec::encode(envelope());
+  for (auto _ : state)
+  {
+    auto const json = Codec::decode_lazy(bytes);
+    benchmark::DoNotOptimize(cxx::get<std::int64_t>(json["id"]));
+    benchmark::DoNotOptimize(cxx::get<std::string>(json["kind"]).data());
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * std::size(bytes)));
+}
+
+template <typename Codec>
+static void cxx_lookup_document(benchmark::State& state)
+{
+  auto const json = Codec::decode(Codec::encode(document()));
+  for (auto _ : state)
+  {
+    double total = 0;
+    for (auto const& record : cxx::get<cxx::json::array>(json))
+      total += cxx::get<double>(record["score"]) +
+               static_cast<double>(cxx::get<std::int64_t>(record["position"]["y"]));
+    benchmark::DoNotOptimize(total);
+  }
+}
+
+template <typename Codec>
+static void cxx_lookup_document_tape(benchmark::State& state)
+{
+  auto const tape = Codec::decode_tape(Codec::encode(document()));
+  for (auto _ : state)
+  {
+    double total = 0;
+    for (auto const record : cxx::get<cxx::tape::array>(tape.root()))
+      total += cxx::get<double>(record["score"]) +
+               static_cast<double>(cxx::get<std::int64_t>(record["position"]["y"]));
+    benchmark::DoNotOptimize(total);
+  }
+}
+
 BENCHMARK_TEMPLATE(cxx_decode_array, cxx::cbor);
 BENCHMARK_TEMPLATE(cxx_decode_array, cxx::msgpack);
 BENCHMARK_TEMPLATE(cxx_decode_bool, cxx::cbor);
@@ -77,6 +281,27 @@ BENCHMARK_TEMPLATE(cxx_decode_byte_stream, cxx::cbor);
 BENCHMARK_TEMPLATE(cxx_decode_byte_stream, cxx::msgpack);
 BENCHMARK_TEMPLATE(cxx_decode_dictionary, cxx::cbor);
 BENCHMARK_TEMPLATE(cxx_decode_dictionary, cxx::msgpack);
+BENCHMARK_TEMPLATE(cxx_decode_dictionary_arena, cxx::cbor);
+BENCHMARK_TEMPLATE(cxx_decode_dictionary_arena, cxx::msgpack);
+BENCHMARK_TEMPLATE(cxx_decode_document, cxx::cbor);
+BENCHMARK_TEMPLATE(cxx_decode_document, cxx::msgpack);
+BENCHMARK_TEMPLATE(cxx_decode_document, text);
+BENCHMARK_TEMPLATE(cxx_decode_document_pmr, cxx::cbor);
+BENCHMARK_TEMPLATE(cxx_decode_document_pmr, cxx::msgpack);
+BENCHMARK_TEMPLATE(cxx_decode_document_pool, cxx::cbor);
+BENCHMARK_TEMPLATE(cxx_decode_document_pool, cxx::msgpack);
+BENCHMARK_TEMPLATE(cxx_decode_document_into, cxx::cbor);
+BENCHMARK_TEMPLATE(cxx_decode_document_into, cxx::msgpack);
+BENCHMARK_TEMPLATE(cxx_decode_document_concat, cxx::cbor);
+BENCHMARK_TEMPLATE(cxx_decode_document_concat, cxx::msgpack);
+BENCHMARK_TEMPLATE(cxx_decode_document_segments, cxx::cbor);
+BENCHMARK_TEMPLATE(cxx_decode_document_segments, cxx::msgpack);
+BENCHMARK_TEMPLATE(cxx_decode_document_arena, cxx::cbor);
+BENCHMARK_TEMPLATE(cxx_decode_document_arena, cxx::msgpack);
+BENCHMARK_TEMPLATE(cxx_decode_document_tape, cxx::cbor);
+BENCHMARK_TEMPLATE(cxx_decode_document_tape, cxx::msgpack);
+BENCHMARK_TEMPLATE(cxx_decode_document_view, cxx::cbor);
+BENCHMARK_TEMPLATE(cxx_decode_document_view, cxx::msgpack);
 BENCHMARK_TEMPLATE(cxx_decode_double, cxx::cbor);
 BENCHMARK_TEMPLATE(cxx_decode_double, cxx::msgpack);
 BENCHMARK_TEMPLATE(cxx_decode_negative_integers, cxx::cbor)
@@ -99,3 +324,29 @@ BENCHMARK_TEMPLATE(cxx_decode_positive_integers, cxx::msgpack)
     ->Complexity();
 BENCHMARK_TEMPLATE(cxx_decode_unicode_string, cxx::cbor);
 BENCHMARK_TEMPLATE(cxx_decode_unicode_string, cxx::msgpack);
+BENCHMARK_TEMPLATE(cxx_lookup_document, cxx::msgpack);
+BENCHMARK_TEMPLATE(cxx_read_envelope, cxx::cbor);
+BENCHMARK_TEMPLATE(cxx_read_envelope, cxx::msgpack);
+BENCHMARK_TEMPLATE(cxx_read_envelope_lazy, cxx::cbor);
+BENCHMARK_TEMPLATE(cxx_read_envelope_lazy, cxx::msgpack);
+BENCHMARK_TEMPLATE(cxx_lookup_document_tape, cxx::msgpack);
+
+template <typename Dictionary>
+static void cxx_dictionary_lookup(benchmark::State& state)
+{
+  Dictionary dict;
+  std::vector<std::string> keys;
+  for (std::int64_t i = 0; i < state.range(0); ++i)
+  {
+    keys.push_back("property_" + std::to_string(i * 7919 % 1000));
+    dict.try_emplace(keys.back(), i);
+  }
+  for (auto _ : state)
+    for (auto const& key : keys) benchmark::DoNotOptimize(dict.find(key));
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(cxx_dictionary_lookup, std::map<std::string, cxx::json>)
+    ->RangeMultiplier(2)
+    ->Range(4, 256);
+BENCHMARK_TEMPLATE(cxx_dictionary_lookup, cxx::json::dictionary)->RangeMultiplier(2)->Range(4, 256);
@@ -54,6 +54,103 @@ static void cxx_encode_long_string(benchmark::State& state)
   for (auto _ : state) benchmark::DoNotOptimize(Codec::encode(json));
 }
 
+static cxx::json document()
+{
+  cxx::json::array records;
+  for (std::int64_t i = 0; i < 256; ++i)
+  {
+    records.push_back({
+        // clang-format off
+        "id"_key >> i,
+        "name"_key >> "lorem ipsum dolor sit amet",
+        "score"_key >> 0.25 * static_cast<double>(i),
+        "tags"_key >> cxx::json{"consectetur", "adipiscing", "elit"},
+        "position"_key >> cxx::json{"x"_key >> -i, "y"_key >> i * 1000, "z"_key >> cxx::json::null}
+        // clang-format on
+    });
+  }
+  return records;
+}
+
+template <typename Codec>
+static void cxx_encode_document(benchmark::State& state)
+{
+  auto const json = document();
+  for (auto _ : state) benchmark::DoNotOptimize(Codec::encode(json));
+}
+
+template <typename Codec>
+static void cxx_encode_document_into(benchmark::State& state)
+{
+  auto const json = document();
+  cxx::json::byte_stream out;
+  for (auto _ : state)
+  {
+    out.clear();
+    Codec::encode_into(json, cxx::by_ref(out));
+    benchmark::DoNotOptimize(out.data());
+  }
+}
+
+template <typename Codec>
+static void cxx_encode_document_to(benchmark::State& state)
+{
+  auto const json = document();
+  cxx::json::byte_stream out(Codec::encoded_size(json));
+  for (auto _ : state) benchmark::DoNotOptimize(Codec::encode_to(json, out.data(), std::size(out)));
+}
+
+template <typename Codec>
+static void cxx_encode_document_chain(benchmark::State& state)
+{
+  auto const json = document();
+  cxx::byte_chain out;
+  for (auto _ : state)
+  {
+    out.clear();
+    Codec::encode_into(json, cxx::by_ref(out));
+    benchmark::DoNotOptimize(out.iovecs().data());
+  }
+}
+
+static cxx::json bulk()
+{
+  cxx::json::array records;
+  for (std::int64_t i = 0; i < 64; ++i)
+  {
+    records.push_back({"id"_key >> i, "name"_key >> "lorem ipsum dolor sit amet",
+                       "blob"_key >> cxx::json::byte_stream(0x10000, cxx::byte{0x2a})});
+  }
+  return records;
+}
+
+template <typename Codec>
+static void cxx_encode_bulk(benchmark::State& state)
+{
+  auto const json = bulk();
+  for (auto _ : state) benchmark::DoNotOptimize(Codec::encode(json));
+}
+
+template <typename Codec>
+static void cxx_encode_bulk_chain(benchmark::State& state)
+{
+  auto const json = bulk();
+  cxx::byte_chain out;
+  for (auto _ : state)
+  {
+    out.clear();
+    Codec::encode_into(json, cxx::by_ref(out));
+    benchmark::DoNotOptimize(out.iovecs().data());
+  }
+}
+
+template <typename Codec>
+static void cxx_encoded_size(benchmark::State& state)
+{
+  auto const json = document();
+  for (auto _ : state) benchmark::DoNotOptimize(Codec::encoded_size(json));
+}
+
 template <std::int64_t N>
 using Int = std::integral_constant<std::int64_t, N>;
 
@@ -131,6 +228,20 @@ BENCHMARK_TEMPLATE(cxx_encode, std::string, cxx::cbor);
 BENCHMARK_TEMPLATE(cxx_encode, std::string, cxx::msgpack);
 BENCHMARK_TEMPLATE(cxx_encode, std::true_type, cxx::cbor);
 BENCHMARK_TEMPLATE(cxx_encode, std::true_type, cxx::msgpack);
+BENCHMARK_TEMPLATE(cxx_encode_document, cxx::cbor);
+BENCHMARK_TEMPLATE(cxx_encode_document, cxx::msgpack);
+BENCHMARK_TEMPLATE(cxx_encode_document_into, cxx::cbor);
+BENCHMARK_TEMPLATE(cxx_encode_document_into, cxx::msgpack);
+BENCHMARK_TEMPLATE(cxx_encode_document_to, cxx::cbor);
+BENCHMARK_TEMPLATE(cxx_encode_document_to, cxx::msgpack);
+BENCHMARK_TEMPLATE(cxx_encode_document_chain, cxx::cbor);
+BENCHMARK_TEMPLATE(cxx_encode_document_chain, cxx::msgpack);
+BENCHMARK_TEMPLATE(cxx_encode_bulk, cxx::cbor);
+BENCHMARK_TEMPLATE(cxx_encode_bulk, cxx::msgpack);
+BENCHMARK_TEMPLATE(cxx_encode_bulk_chain, cxx::cbor);
+BENCHMARK_TEMPLATE(cxx_encode_bulk_chain, cxx::msgpack);
+BENCHMARK_TEMPLATE(cxx_encoded_size, cxx::cbor);
+BENCHMARK_TEMPLATE(cxx_encoded_size, cxx::msgpack);
 BENCHMARK_TEMPLATE(cxx_encode_long_string, cxx::cbor);
 BENCHMARK_TEMPLATE(cxx_encode_long_string, cxx::msgpack);
 BENCHMARK_TEMPLATE(cxx_encode_non_empty_array, cxx::cbor);
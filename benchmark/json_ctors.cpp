@@ -1,5 +1,6 @@
 #include <benchmark/benchmark.h>
 #include "inc/cxx/json.hpp"
+#include "inc/cxx/persistent.hpp"
 
 static void cxx_json_default_ctor(benchmark::State& state)
 {
@@ -28,3 +29,56 @@ BENCHMARK_TEMPLATE(cxx_json_ctor, cxx::json::byte_stream);
 BENCHMARK_TEMPLATE(cxx_json_ctor, cxx::json::null_t);
 BENCHMARK_TEMPLATE(cxx_json_ctor, cxx::json::array);
 BENCHMARK_TEMPLATE(cxx_json_ctor, cxx::json::dictionary);
+
+static cxx::json const& config()
+{
+  static auto const ret = [] {
+    cxx::json::dictionary sections;
+    for (int i = 0; i < 64; ++i)
+    {
+      cxx::json::dictionary section;
+      for (int j = 0; j < 32; ++j)
+        section.try_emplace("option_" + std::to_string(j), "value_" + std::to_string(i * j));
+      sections.try_emplace("section_" + std::to_string(i), std::move(section));
+    }
+    return cxx::json(std::move(sections));
+  }();
+  return ret;
+}
+
+static void cxx_json_copy_config(benchmark::State& state)
+{
+  cxx::json const orig = config();
+  for (auto _ : state) benchmark::DoNotOptimize(cxx::json(orig));
+}
+BENCHMARK(cxx_json_copy_config);
+
+static void cxx_persistent_copy_config(benchmark::State& state)
+{
+  cxx::persistent const orig(config());
+  for (auto _ : state) benchmark::DoNotOptimize(cxx::persistent(orig));
+}
+BENCHMARK(cxx_persistent_copy_config);
+
+static void cxx_json_update_config(benchmark::State& state)
+{
+  cxx::json const orig = config();
+  for (auto _ : state)
+  {
+    cxx::json copy = orig;
+    copy["section_42"]["option_7"] = "updated";
+    benchmark::DoNotOptimize(copy);
+  }
+}
+BENCHMARK(cxx_json_update_config);
+
+static void cxx_persistent_update_config(benchmark::State& state)
+{
+  cxx::persistent const orig(config());
+  for (auto _ : state)
+  {
+    auto const copy = orig.with("section_42", orig["section_42"].with("option_7", "updated"));
+    benchmark::DoNotOptimize(copy);
+  }
+}
+BENCHMARK(cxx_persistent_update_config);
@@ -0,0 +1,47 @@
+#include <benchmark/benchmark.h>
+#include "inc/cxx/json.hpp"
+
+static cxx::json wide(std::int64_t size)
+{
+  cxx::json::array ret;
+  ret.reserve(static_cast<std::size_t>(size));
+  for (std::int64_t i = 0; i < size; ++i)
+  {
+    cxx::json::dictionary record;
+    record.try_emplace("id", i);
+    record.try_emplace("tags", cxx::json::array{"lorem", "ipsum"});
+    record.try_emplace("position", cxx::json::dictionary{{"x", i}, {"y", -i}});
+    ret.push_back(std::move(record));
+  }
+  return ret;
+}
+
+static cxx::json deep(std::int64_t depth)
+{
+  cxx::json ret = cxx::json::array();
+  auto* node = &ret;
+  for (std::int64_t i = 0; i < depth; ++i)
+  {
+    auto& items = cxx::get<cxx::json::array>(*node);
+    items.emplace_back(i);
+    items.emplace_back(cxx::json::dictionary{{"next", cxx::json::array()}});
+    node = &cxx::get<cxx::json::dictionary>(items.back()).at("next");
+  }
+  return ret;
+}
+
+template <cxx::json (*Make)(std::int64_t)>
+static void cxx_json_dtor(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    auto* x = new cxx::json(Make(state.range(0)));
+    state.ResumeTiming();
+    delete x;
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(cxx_json_dtor, wide)->Arg(1 << 16)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(cxx_json_dtor, deep)->Arg(1 << 12)->Unit(benchmark::kMicrosecond);
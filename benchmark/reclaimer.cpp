@@ -0,0 +1,45 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include "inc/cxx/reclaimer.hpp"
+
+static cxx::json document(std::int64_t size)
+{
+  cxx::json::array ret;
+  ret.reserve(static_cast<std::size_t>(size));
+  for (std::int64_t i = 0; i < size; ++i)
+    ret.push_back(cxx::json::dictionary{{"id", i},
+                                        {"tags", cxx::json{"lorem", "ipsum"}},
+                                        {"position", cxx::json{{"x", i}, {"y", -i}}}});
+  return ret;
+}
+
+struct inline_free {
+  void operator()(cxx::json&& x) const { x = cxx::json::null; }
+};
+
+struct deferred_free {
+  void operator()(cxx::json&& x) const { cxx::defer_destroy(std::move(x)); }
+};
+
+template <typename Free>
+static void cxx_drop_document(benchmark::State& state)
+{
+  std::vector<double> latencies;
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    auto x = document(state.range(0));
+    state.ResumeTiming();
+    auto const start = std::chrono::steady_clock::now();
+    Free()(std::move(x));
+    auto const stop = std::chrono::steady_clock::now();
+    latencies.push_back(std::chrono::duration<double, std::micro>(stop - start).count());
+  }
+  std::sort(std::begin(latencies), std::end(latencies));
+  state.counters["p50_us"] = latencies[std::size(latencies) / 2];
+  state.counters["p99_us"] = latencies[std::size(latencies) * 99 / 100];
+}
+
+BENCHMARK_TEMPLATE(cxx_drop_document, inline_free)->Arg(1 << 14)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(cxx_drop_document, deferred_free)->Arg(1 << 14)->Unit(benchmark::kMicrosecond);
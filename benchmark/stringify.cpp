@@ -0,0 +1,170 @@
+#include <benchmark/benchmark.h>
+#include "inc/cxx/json.hpp"
+#include <iomanip>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace cxx::literals;
+
+namespace legacy
+{
+  std::string to_string(cxx::json const&);
+
+  auto const serializer =
+      cxx::overload{[](cxx::json::null_t) -> std::string { return "null"; },
+                    [](std::int64_t x) -> std::string { return std::to_string(x); },
+                    [](double x) -> std::string { return std::to_string(x); },
+                    [](bool x) -> std::string { return x ? "true" : "false"; },
+                    [](std::string const& x) -> std::string {
+                      std::stringstream ss;
+                      ss << std::quoted(x);
+                      return ss.str();
+                    },
+                    [](cxx::json::array const& array) -> std::string {
+                      if (std::empty(array)) return "[]";
+                      std::stringstream ss;
+                      ss << "[";
+                      for (auto const& x : array) ss << legacy::to_string(x) << ", ";
+                      auto ret = ss.str();
+                      ret.pop_back();
+                      ret.back() = ']';
+                      return ret;
+                    },
+                    [](cxx::json::dictionary const& dict) -> std::string {
+                      if (std::empty(dict)) return "{}";
+                      std::stringstream ss;
+                      ss << "{";
+                      for (auto const& [key, value] : dict)
+                      { ss << std::quoted(key) << ": " << legacy::to_string(value) << ", "; }
+                      auto ret = ss.str();
+                      ret.pop_back();
+                      ret.back() = '}';
+                      return ret;
+                    },
+                    [](cxx::json::byte_stream const&) -> std::string {
+                      throw std::invalid_argument("bytes are not JSON serializable");
+                    }};
+
+  std::string to_string(cxx::json const& json) { return cxx::visit(serializer, json); }
+} // namespace legacy
+
+static cxx::json nested(std::int64_t depth)
+{
+  cxx::json json = {"id"_key >> depth, "name"_key >> "lorem ipsum", "flag"_key >> true};
+  if (depth == 0) return json;
+  cxx::json::array children;
+  for (auto i = 0; i < 4; ++i) children.push_back(nested(depth - 1));
+  json["children"] = std::move(children);
+  json["values"] = {depth, -depth, depth * 1000000, cxx::json::null};
+  return json;
+}
+
+template <typename F>
+static void run(benchmark::State& state, cxx::json const& json, F to_string)
+{
+  std::size_t bytes = 0;
+  for (auto _ : state)
+  {
+    auto const& str = to_string(json);
+    benchmark::DoNotOptimize(str.data());
+    bytes += std::size(str);
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(bytes));
+}
+
+static void legacy_to_string_nested(benchmark::State& state)
+{
+  run(state, nested(state.range(0)), [](cxx::json const& x) { return legacy::to_string(x); });
+}
+
+static void cxx_to_string_nested(benchmark::State& state)
+{
+  run(state, nested(state.range(0)), [](cxx::json const& x) { return cxx::to_string(x); });
+}
+
+static void cxx_to_string_reused_nested(benchmark::State& state)
+{
+  std::string out;
+  run(state, nested(state.range(0)), [&out](cxx::json const& x) -> std::string const& {
+    cxx::to_string(x, cxx::by_ref(out));
+    return out;
+  });
+}
+
+BENCHMARK(legacy_to_string_nested)->DenseRange(1, 5, 2);
+BENCHMARK(cxx_to_string_nested)->DenseRange(1, 5, 2);
+BENCHMARK(cxx_to_string_reused_nested)->DenseRange(1, 5, 2);
+
+static void cxx_to_string_doubles(benchmark::State& state)
+{
+  cxx::json::array array;
+  auto x = 0.1;
+  for (auto i = 0; i < state.range(0); ++i)
+  {
+    array.emplace_back(x);
+    x = x * 1.618033988749895 + 1e-3 * i;
+    if (x > 1e12) x /= 1e15;
+  }
+  cxx::json const json = std::move(array);
+  std::string out;
+  std::size_t bytes = 0;
+  for (auto _ : state)
+  {
+    cxx::to_string(json, cxx::by_ref(out));
+    benchmark::DoNotOptimize(out.data());
+    bytes += std::size(out);
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(bytes));
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * state.range(0)));
+}
+
+BENCHMARK(cxx_to_string_doubles)->Range(1 << 6, 1 << 14);
+
+static cxx::json log_lines(std::size_t size)
+{
+  cxx::json::array array;
+  std::string line = "2026-10-18T06:40:00Z worker-7 request handled path=/api/v1/items ";
+  while (std::size(line) < size) line += "lorem ipsum dolor sit amet consectetur adipiscing elit ";
+  for (auto i = 0; i < 64; ++i) array.emplace_back(line);
+  array.emplace_back("multi\nline\t\"quoted\" entry");
+  return array;
+}
+
+static void legacy_to_string_strings(benchmark::State& state)
+{
+  auto const json = log_lines(static_cast<std::size_t>(state.range(0)));
+  run(state, json, [](cxx::json const& x) { return legacy::to_string(x); });
+}
+
+static void cxx_to_string_strings(benchmark::State& state)
+{
+  auto const json = log_lines(static_cast<std::size_t>(state.range(0)));
+  std::string out;
+  run(state, json, [&out](cxx::json const& x) -> std::string const& {
+    cxx::to_string(x, cxx::by_ref(out));
+    return out;
+  });
+}
+
+BENCHMARK(legacy_to_string_strings)->Range(64, 4096);
+BENCHMARK(cxx_to_string_strings)->Range(64, 4096);
+
+static void cxx_write_fd_nested(benchmark::State& state)
+{
+  auto const json = nested(state.range(0));
+  auto const size = std::size(cxx::to_string(json));
+  auto const fd = ::open("/dev/null", O_WRONLY);
+  for (auto _ : state) cxx::write(json, fd);
+  ::close(fd);
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * size));
+}
+
+static void cxx_to_string_compact_nested(benchmark::State& state)
+{
+  run(state, nested(state.range(0)),
+      [](cxx::json const& x) { return cxx::to_string(x, cxx::layout{true}); });
+}
+
+BENCHMARK(cxx_write_fd_nested)->DenseRange(1, 5, 2);
+BENCHMARK(cxx_to_string_compact_nested)->DenseRange(1, 5, 2);
@@ -0,0 +1,20 @@
+#include "inc/cxx/json.hpp"
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+  std::string_view text(reinterpret_cast<char const*>(data), size);
+  try
+  {
+    while (!std::empty(text))
+    {
+      auto const json = cxx::parse(cxx::by_ref(text));
+      cxx::to_string(json);
+    }
+  } catch (cxx::parse_error const&)
+  {
+  };
+  return 0;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace cxx
+{
+  /*
+   * Bump pointer memory resource. Deallocation is a no-op, reset() rewinds all blocks at once
+   * and keeps them for reuse. Objects created with construct are never destroyed, they must not
+   * own memory from anywhere else.
+   */
+  class arena : public std::pmr::memory_resource
+  {
+  public:
+    /*
+     *
+     */
+    static constexpr std::size_t const default_block_size = 64 * 1024;
+
+    explicit arena(std::size_t block_size = default_block_size);
+    arena(arena const&) = delete;
+    arena& operator=(arena const&) = delete;
+    ~arena() override;
+
+    /*
+     * invalidates everything allocated so far
+     */
+    void reset() noexcept;
+
+    /*
+     *
+     */
+    std::size_t used() const noexcept;
+    std::size_t capacity() const noexcept;
+
+    /*
+     *
+     */
+    template <typename T, typename... Args>
+    T& construct(Args&&... args)
+    {
+      return *::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+  private:
+    struct block {
+      std::unique_ptr<std::byte[]> data;
+      std::size_t size;
+    };
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void*, std::size_t, std::size_t) noexcept override {}
+    bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override;
+
+    void* grow(std::size_t bytes, std::size_t alignment);
+
+    std::vector<block> blocks;
+    std::size_t current = 0;
+    std::size_t before = 0;
+    std::byte* cursor = nullptr;
+    std::byte* limit = nullptr;
+  };
+} // namespace cxx
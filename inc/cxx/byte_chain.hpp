@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cxx/json.hpp>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <sys/uio.h>
+
+namespace cxx
+{
+  struct codec;
+
+  /*
+   * Encoder output kept as a chain of fixed size segments instead of one contiguous stream, so
+   * growing it never copies what was already written. Payloads of at least min_reference bytes
+   * are not copied either, the chain points at the encoded byte stream or string; these must
+   * stay alive and unchanged as long as the chain is read. clear keeps the segments for reuse.
+   */
+  class byte_chain
+  {
+  public:
+    /*
+     *
+     */
+    static constexpr std::size_t const default_segment_size = 0x10000;
+    static constexpr std::size_t const default_min_reference = 0x1000;
+
+    explicit byte_chain(std::size_t segment_size = default_segment_size,
+                        std::size_t min_reference = default_min_reference);
+    byte_chain(byte_chain&&) noexcept = default;
+    byte_chain& operator=(byte_chain&&) noexcept = default;
+    byte_chain(byte_chain const&) = delete;
+    byte_chain& operator=(byte_chain const&) = delete;
+
+    /*
+     * total number of bytes
+     */
+    std::size_t size() const noexcept { return total; }
+    bool empty() const noexcept { return total == 0; }
+
+    /*
+     * content in order, ready for writev; it takes at most IOV_MAX entries per call
+     */
+    std::vector<iovec> const& iovecs() const noexcept { return pieces; }
+
+    /*
+     * contiguous copy of the content
+     */
+    json::byte_stream flatten() const;
+
+    /*
+     * drops the content, keeping the segments
+     */
+    void clear() noexcept;
+
+  private:
+    friend struct codec;
+
+    /*
+     * writable range of at least n bytes past the content, starting a new segment if the
+     * current one has less room left
+     */
+    std::pair<cxx::byte*, cxx::byte*> open(std::size_t n);
+
+    /*
+     * appends the bytes written to the open range up to end
+     */
+    void close(cxx::byte* end);
+
+    /*
+     * appends n bytes at data without copying them
+     */
+    void reference(cxx::byte const* data, std::size_t n);
+
+    std::size_t segment_size;
+    std::size_t min_reference;
+    std::vector<std::unique_ptr<cxx::byte[]>> segments;
+    std::size_t used = 0;
+    cxx::byte* mark = nullptr;
+    cxx::byte* last = nullptr;
+    std::vector<iovec> pieces;
+    std::size_t total = 0;
+  };
+} // namespace cxx
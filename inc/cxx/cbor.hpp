@@ -1,6 +1,13 @@
 #pragma once
+#include <cxx/arena.hpp>
 #include <cxx/json.hpp>
+#include <cxx/json_view.hpp>
+#include <cxx/lazy.hpp>
+#include <cxx/tape.hpp>
 #include <cxx/by_ref.hpp>
+#include <cxx/byte_chain.hpp>
+#include <optional>
+#include <stdexcept>
 #include <string_view>
 
 namespace cxx
@@ -25,7 +32,93 @@ namespace cxx
     static constexpr std::size_t const max_size = 0xffff;
     static constexpr std::size_t const max_nesting = 0x3f;
     static json::byte_stream encode(json const&) noexcept;
+
+    template <template <typename> typename Allocator>
+    static json::byte_stream encode(basic_json<Allocator> const&) noexcept;
+
+    /*
+     * appends to out, keeping its content and capacity
+     */
+    static void encode_into(json const&, cxx::by_ref<json::byte_stream> out) noexcept;
+
+    template <template <typename> typename Allocator>
+    static void encode_into(basic_json<Allocator> const&,
+                            cxx::by_ref<json::byte_stream> out) noexcept;
+
+    /*
+     * appends to the chain, large byte streams and strings of the json are referenced and
+     * have to outlive it
+     */
+    static void encode_into(json const&, cxx::by_ref<byte_chain> out) noexcept;
+
+    template <template <typename> typename Allocator>
+    static void encode_into(basic_json<Allocator> const&, cxx::by_ref<byte_chain> out) noexcept;
+
+    /*
+     * exact number of bytes encode produces, without encoding
+     */
+    static std::size_t encoded_size(json const&) noexcept;
+
+    template <template <typename> typename Allocator>
+    static std::size_t encoded_size(basic_json<Allocator> const&) noexcept;
+
+    /*
+     * writes to the size bytes at out and returns how many were written, returns nullopt and
+     * leaves out untouched if the encoding does not fit
+     */
+    static std::optional<std::size_t> encode_to(json const&, cxx::byte* out,
+                                                std::size_t size) noexcept;
+
+    template <template <typename> typename Allocator>
+    static std::optional<std::size_t> encode_to(basic_json<Allocator> const&, cxx::byte* out,
+                                                std::size_t size) noexcept;
+
     static json decode(json::byte_stream const&);
     static json decode(cxx::by_ref<json::byte_view>);
+
+    /*
+     * message received in several buffers, only items straddling two of them are copied
+     */
+    static json decode(std::vector<json::byte_view> const& segments);
+    static json decode(std::vector<iovec> const& segments);
+
+    /*
+     * every string and container of the result is allocated from resource
+     */
+    static pmr::json decode(json::byte_stream const&, std::pmr::memory_resource*);
+    static pmr::json decode(cxx::by_ref<json::byte_view>, std::pmr::memory_resource*);
+
+    /*
+     * result lives in the arena as well and is never destroyed, arena::reset releases it
+     */
+    static pmr::json& decode(json::byte_stream const&, cxx::arena&);
+    static pmr::json& decode(cxx::by_ref<json::byte_view>, cxx::arena&);
+
+    /*
+     * flat read-only representation, see cxx::tape
+     */
+    static tape decode_tape(json::byte_stream const&);
+    static tape decode_tape(cxx::by_ref<json::byte_view>);
+
+    /*
+     * strings, byte streams and keys of the result point into the decoded bytes
+     */
+    static json_view decode_view(json::byte_stream const&);
+    static json_view decode_view(json::byte_stream&&) = delete;
+    static json_view decode_view(cxx::by_ref<json::byte_view>);
+
+    /*
+     * subtrees are decoded on first access and must not outlive the decoded bytes
+     */
+    static lazy decode_lazy(json::byte_stream const&);
+    static lazy decode_lazy(json::byte_stream&&) = delete;
+    static lazy decode_lazy(cxx::by_ref<json::byte_view>);
+
+    /*
+     * overwrites target, reusing the capacity of its strings, byte streams and containers where
+     * the decoded shape matches; target holds some valid value if decoding fails
+     */
+    static void decode_into(json::byte_stream const&, cxx::by_ref<json> target);
+    static void decode_into(cxx::by_ref<json::byte_view>, cxx::by_ref<json> target);
   };
 } // namespace cxx
@@ -0,0 +1,261 @@
+#pragma once
+
+#include <cxx/json.hpp>
+#include <type_traits>
+#include <variant>
+
+namespace cxx
+{
+  /*
+   * 16 byte json node. Scalars and strings up to 15 bytes are stored inline,
+   * containers and longer strings live out of line behind a pointer.
+   * Strings are exposed as std::string_view, default constructed node is null.
+   */
+  class compact
+  {
+  public:
+    /*
+     *
+     */
+    using null_t = json::null_t;
+    static constexpr null_t null{};
+
+    /*
+     *
+     */
+    using byte_stream = json::byte_stream;
+
+    /*
+     *
+     */
+    using dictionary = cxx::flat_map<std::string, compact>;
+
+    /*
+     *
+     */
+    using array = std::vector<compact>;
+
+    compact() noexcept : compact(null) {}
+    compact(null_t) noexcept { u.text.meta = meta(tag::null); }
+    compact(bool x) noexcept
+    {
+      u.boolean = x;
+      u.text.meta = meta(tag::boolean);
+    }
+
+    template <typename T,
+              typename = std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>>
+    compact(T x) noexcept
+    {
+      u.integer = static_cast<std::int64_t>(x);
+      u.text.meta = meta(tag::integer);
+    }
+
+    compact(double x) noexcept
+    {
+      u.real = x;
+      u.text.meta = meta(tag::real);
+    }
+
+    compact(std::string_view);
+    compact(char const* x) : compact(std::string_view(x)) {}
+    compact(std::string const& x) : compact(std::string_view(x)) {}
+    compact(dictionary);
+    compact(array);
+    compact(byte_stream);
+
+    /*
+     * converts whole tree
+     */
+    explicit compact(json const&);
+
+    compact(compact const&);
+    compact(compact&& other) noexcept : u(other.u) { other.u.text.meta = meta(tag::null); }
+    compact& operator=(compact const&);
+    compact& operator=(compact&&) noexcept;
+    ~compact() { release(); }
+
+    /*
+     * T is one of dictionary, std::int64_t, array, std::string_view, byte_stream, double, bool
+     * or null_t; throws std::bad_variant_access if other alternative is held
+     */
+    template <typename T>
+    decltype(auto) get()
+    {
+      return compact::access<T>(*this);
+    }
+
+    template <typename T>
+    decltype(auto) get() const
+    {
+      return compact::access<T>(*this);
+    }
+
+    /*
+     *
+     */
+    template <typename T>
+    bool holds_alternative() const noexcept
+    {
+      if constexpr (std::is_same_v<T, std::string_view>)
+        return type() == tag::string || type() == tag::small;
+      else
+        return type() == compact::tag_of<T>();
+    }
+
+    /*
+     *
+     */
+    template <typename F>
+    decltype(auto) visit(F&& f)
+    {
+      return compact::dispatch(*this, std::forward<F>(f));
+    }
+
+    template <typename F>
+    decltype(auto) visit(F&& f) const
+    {
+      return compact::dispatch(*this, std::forward<F>(f));
+    }
+
+    /*
+     *
+     */
+    compact& operator[](std::string const&);
+    compact const& operator[](std::string const&) const;
+
+    /*
+     *
+     */
+    compact& operator[](std::size_t);
+    compact const& operator[](std::size_t) const;
+
+    /*
+     *
+     */
+    std::size_t size() const noexcept;
+    bool empty() const noexcept;
+
+  private:
+    enum class tag : std::uint8_t {
+      dictionary,
+      integer,
+      array,
+      string,
+      bytes,
+      real,
+      boolean,
+      null,
+      small
+    };
+
+    static constexpr std::size_t const small_capacity = 15;
+
+    static constexpr std::uint8_t meta(tag t, std::size_t size = 0) noexcept
+    {
+      return static_cast<std::uint8_t>(static_cast<std::size_t>(t) | (size << 4));
+    }
+
+    tag type() const noexcept { return static_cast<tag>(u.text.meta & 0xf); }
+    std::size_t small_size() const noexcept { return u.text.meta >> 4; }
+
+    template <typename T>
+    static constexpr tag tag_of() noexcept
+    {
+      if constexpr (std::is_same_v<T, dictionary>) return tag::dictionary;
+      else if constexpr (std::is_same_v<T, std::int64_t>)
+        return tag::integer;
+      else if constexpr (std::is_same_v<T, array>)
+        return tag::array;
+      else if constexpr (std::is_same_v<T, byte_stream>)
+        return tag::bytes;
+      else if constexpr (std::is_same_v<T, double>)
+        return tag::real;
+      else if constexpr (std::is_same_v<T, bool>)
+        return tag::boolean;
+      else
+      {
+        static_assert(std::is_same_v<T, null_t>, "not an alternative of cxx::compact");
+        return tag::null;
+      }
+    }
+
+    template <typename Self, typename T>
+    using ref = std::conditional_t<std::is_const_v<Self>, T const&, T&>;
+
+    template <typename T, typename Self>
+    static decltype(auto) access(Self& self)
+    {
+      if (!self.template holds_alternative<T>()) throw std::bad_variant_access();
+      if constexpr (std::is_same_v<T, std::string_view>)
+        return self.view();
+      else if constexpr (std::is_same_v<T, dictionary>)
+        return static_cast<ref<Self, T>>(*self.u.dict);
+      else if constexpr (std::is_same_v<T, array>)
+        return static_cast<ref<Self, T>>(*self.u.items);
+      else if constexpr (std::is_same_v<T, byte_stream>)
+        return static_cast<ref<Self, T>>(*self.u.bytes);
+      else if constexpr (std::is_same_v<T, std::int64_t>)
+        return static_cast<ref<Self, T>>(self.u.integer);
+      else if constexpr (std::is_same_v<T, double>)
+        return static_cast<ref<Self, T>>(self.u.real);
+      else if constexpr (std::is_same_v<T, bool>)
+        return static_cast<ref<Self, T>>(self.u.boolean);
+      else
+        return null_t{};
+    }
+
+    template <typename Self, typename F>
+    static decltype(auto) dispatch(Self& self, F&& f)
+    {
+      switch (self.type())
+      {
+        case tag::dictionary:
+          return f(static_cast<ref<Self, dictionary>>(*self.u.dict));
+        case tag::integer:
+          return f(static_cast<ref<Self, std::int64_t>>(self.u.integer));
+        case tag::array:
+          return f(static_cast<ref<Self, array>>(*self.u.items));
+        case tag::string:
+        case tag::small:
+          return f(self.view());
+        case tag::bytes:
+          return f(static_cast<ref<Self, byte_stream>>(*self.u.bytes));
+        case tag::real:
+          return f(static_cast<ref<Self, double>>(self.u.real));
+        case tag::boolean:
+          return f(static_cast<ref<Self, bool>>(self.u.boolean));
+        case tag::null:
+          break;
+      }
+      return f(null);
+    }
+
+    std::string_view view() const noexcept
+    {
+      if (type() == tag::small) return std::string_view(u.text.data, small_size());
+      return *u.str;
+    }
+
+    void release() noexcept;
+
+    union storage {
+      std::int64_t integer;
+      double real;
+      bool boolean;
+      dictionary* dict;
+      array* items;
+      std::string* str;
+      byte_stream* bytes;
+      struct {
+        char data[small_capacity];
+        std::uint8_t meta;
+      } text;
+    } u;
+  };
+
+  static_assert(sizeof(compact) == 16);
+
+  bool operator==(compact const& lhs, compact const& rhs) noexcept;
+  bool operator!=(compact const& lhs, compact const& rhs) noexcept;
+} // namespace cxx
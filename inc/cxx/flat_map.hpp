@@ -0,0 +1,307 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cxx
+{
+  /*
+   * Associative container keeping its items in a vector sorted by key. Iteration order is the
+   * one of std::map, lookups in small maps scan linearly, larger ones use binary search.
+   * Keys equivalent under Compare are expected to compare equal.
+   * Unlike std::map any insertion or erasure invalidates iterators and references.
+   */
+  template <typename Key,
+            typename T,
+            typename Compare = std::less<>,
+            typename Allocator = std::allocator<std::pair<Key, T>>>
+  class flat_map
+  {
+  public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+    using key_compare = Compare;
+    using allocator_type = Allocator;
+    using container_type = std::vector<value_type, Allocator>;
+    using size_type = typename container_type::size_type;
+    using difference_type = typename container_type::difference_type;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+    using iterator = typename container_type::iterator;
+    using const_iterator = typename container_type::const_iterator;
+    using reverse_iterator = typename container_type::reverse_iterator;
+    using const_reverse_iterator = typename container_type::const_reverse_iterator;
+
+    /*
+     * maps up to this size are searched linearly, lookups then compare keys for equality
+     * which for strings rejects most candidates on size alone
+     */
+    static constexpr size_type const linear_search_limit = 8;
+
+    flat_map() = default;
+
+    explicit flat_map(Allocator const& alloc) : items(alloc) {}
+
+    /*
+     * keeps first of duplicated keys, like std::map does
+     */
+    template <typename InputIt>
+    flat_map(InputIt first, InputIt last, Allocator const& alloc = Allocator())
+        : items(first, last, alloc)
+    {
+      normalize();
+    }
+
+    flat_map(std::initializer_list<value_type> init, Allocator const& alloc = Allocator())
+        : flat_map(std::begin(init), std::end(init), alloc)
+    {
+    }
+
+    /*
+     * builds from other associative containers, e.g. std::map
+     */
+    template <typename Range,
+              typename = std::enable_if_t<
+                  !std::is_same_v<std::decay_t<Range>, flat_map> &&
+                  std::is_constructible_v<value_type, typename Range::value_type const&>>>
+    explicit flat_map(Range const& range, Allocator const& alloc = Allocator())
+        : flat_map(std::begin(range), std::end(range), alloc)
+    {
+    }
+
+    allocator_type get_allocator() const { return items.get_allocator(); }
+    key_compare key_comp() const { return key_compare(); }
+
+    iterator begin() noexcept { return std::begin(items); }
+    const_iterator begin() const noexcept { return std::begin(items); }
+    const_iterator cbegin() const noexcept { return std::cbegin(items); }
+    iterator end() noexcept { return std::end(items); }
+    const_iterator end() const noexcept { return std::end(items); }
+    const_iterator cend() const noexcept { return std::cend(items); }
+    reverse_iterator rbegin() noexcept { return std::rbegin(items); }
+    const_reverse_iterator rbegin() const noexcept { return std::rbegin(items); }
+    reverse_iterator rend() noexcept { return std::rend(items); }
+    const_reverse_iterator rend() const noexcept { return std::rend(items); }
+
+    bool empty() const noexcept { return std::empty(items); }
+    size_type size() const noexcept { return std::size(items); }
+    size_type max_size() const noexcept { return items.max_size(); }
+    size_type capacity() const noexcept { return items.capacity(); }
+    void reserve(size_type n) { items.reserve(n); }
+    void shrink_to_fit() { items.shrink_to_fit(); }
+    void clear() noexcept { items.clear(); }
+
+    /*
+     *
+     */
+    template <typename K>
+    iterator lower_bound(K const& key)
+    {
+      return mutable_iterator(search(key));
+    }
+
+    template <typename K>
+    const_iterator lower_bound(K const& key) const
+    {
+      return search(key);
+    }
+
+    /*
+     *
+     */
+    template <typename K>
+    iterator find(K const& key)
+    {
+      return mutable_iterator(std::as_const(*this).find(key));
+    }
+
+    template <typename K>
+    const_iterator find(K const& key) const
+    {
+      if (size() <= linear_search_limit)
+        return std::find_if(cbegin(), cend(), [&key](auto const& x) { return x.first == key; });
+      auto const it = search(key);
+      return (it != cend() && !key_comp()(key, it->first)) ? it : cend();
+    }
+
+    template <typename K>
+    size_type count(K const& key) const
+    {
+      return find(key) != cend() ? 1 : 0;
+    }
+
+    template <typename K>
+    bool contains(K const& key) const
+    {
+      return find(key) != cend();
+    }
+
+    /*
+     *
+     */
+    template <typename K>
+    mapped_type& at(K const& key)
+    {
+      return const_cast<mapped_type&>(std::as_const(*this).at(key));
+    }
+
+    template <typename K>
+    mapped_type const& at(K const& key) const
+    {
+      auto const it = find(key);
+      if (it == cend()) throw std::out_of_range("cxx::flat_map::at");
+      return it->second;
+    }
+
+    mapped_type& operator[](key_type const& key) { return try_emplace(key).first->second; }
+    mapped_type& operator[](key_type&& key) { return try_emplace(std::move(key)).first->second; }
+
+    /*
+     * appending keys in ascending order takes constant time
+     */
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(key_type const& key, Args&&... args)
+    {
+      return emplace_key(cend(), key, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args)
+    {
+      return emplace_key(cend(), std::move(key), std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    iterator try_emplace(const_iterator hint, key_type const& key, Args&&... args)
+    {
+      return emplace_key(hint, key, std::forward<Args>(args)...).first;
+    }
+
+    template <typename... Args>
+    iterator try_emplace(const_iterator hint, key_type&& key, Args&&... args)
+    {
+      return emplace_key(hint, std::move(key), std::forward<Args>(args)...).first;
+    }
+
+    /*
+     *
+     */
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args)
+    {
+      value_type item(std::forward<Args>(args)...);
+      return emplace_key(cend(), std::move(item.first), std::move(item.second));
+    }
+
+    template <typename... Args>
+    iterator emplace_hint(const_iterator hint, Args&&... args)
+    {
+      value_type item(std::forward<Args>(args)...);
+      return emplace_key(hint, std::move(item.first), std::move(item.second)).first;
+    }
+
+    std::pair<iterator, bool> insert(value_type const& item)
+    {
+      return emplace_key(cend(), item.first, item.second);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& item)
+    {
+      return emplace_key(cend(), std::move(item.first), std::move(item.second));
+    }
+
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+      for (; first != last; ++first) emplace(*first);
+    }
+
+    /*
+     *
+     */
+    iterator erase(iterator pos) { return items.erase(pos); }
+    iterator erase(const_iterator pos) { return items.erase(pos); }
+    iterator erase(const_iterator first, const_iterator last) { return items.erase(first, last); }
+
+    template <typename K, typename = std::enable_if_t<!std::is_convertible_v<K, const_iterator>>>
+    size_type erase(K const& key)
+    {
+      auto const it = find(key);
+      if (it == cend()) return 0;
+      items.erase(it);
+      return 1;
+    }
+
+    void swap(flat_map& other) noexcept { items.swap(other.items); }
+
+    friend bool operator==(flat_map const& lhs, flat_map const& rhs)
+    {
+      return lhs.items == rhs.items;
+    }
+
+    friend bool operator!=(flat_map const& lhs, flat_map const& rhs) { return !(lhs == rhs); }
+
+    friend bool operator<(flat_map const& lhs, flat_map const& rhs)
+    {
+      return lhs.items < rhs.items;
+    }
+
+  private:
+    iterator mutable_iterator(const_iterator it) { return begin() + (it - cbegin()); }
+
+    template <typename K>
+    const_iterator search(K const& key) const
+    {
+      auto const comp = key_comp();
+      if (size() <= linear_search_limit)
+      {
+        auto it = cbegin();
+        while (it != cend() && comp(it->first, key)) ++it;
+        return it;
+      }
+      return std::lower_bound(cbegin(), cend(), key, [&comp](value_type const& x, K const& k) {
+        return comp(x.first, k);
+      });
+    }
+
+    template <typename K, typename... Args>
+    std::pair<iterator, bool> emplace_key(const_iterator hint, K&& key, Args&&... args)
+    {
+      auto const comp = key_comp();
+      if ((hint != cbegin() && !comp(std::prev(hint)->first, key)) ||
+          (hint != cend() && !comp(key, hint->first)))
+      {
+        hint = search(key);
+        if (hint != cend() && !comp(key, hint->first)) return {mutable_iterator(hint), false};
+      }
+      auto const it = items.emplace(hint, std::piecewise_construct,
+                                    std::forward_as_tuple(std::forward<K>(key)),
+                                    std::forward_as_tuple(std::forward<Args>(args)...));
+      return {it, true};
+    }
+
+    void normalize()
+    {
+      auto const comp = key_comp();
+      auto const less = [&comp](value_type const& x, value_type const& y) {
+        return comp(x.first, y.first);
+      };
+      auto const duplicate = [&less](auto const& x, auto const& y) { return !less(x, y); };
+      if (std::adjacent_find(std::begin(items), std::end(items), duplicate) == std::end(items))
+        return;
+      std::stable_sort(std::begin(items), std::end(items), less);
+      auto const last = std::unique(std::begin(items), std::end(items), duplicate);
+      items.erase(last, std::end(items));
+    }
+
+    container_type items;
+  };
+} // namespace cxx
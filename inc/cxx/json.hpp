@@ -1,12 +1,16 @@
 #pragma once
 
+#include <cxx/by_ref.hpp>
+#include <cxx/flat_map.hpp>
+#include <iosfwd>
+#include <memory_resource>
+#include <stdexcept>
 #include <string_view>
 #include <variant>
 #include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
-#include <map>
 
 namespace cxx::traits
 {
@@ -93,9 +97,9 @@ namespace cxx
   using byte = std::byte;
 
   /*
-   *
+   * allocator independent part of basic_json
    */
-  struct json {
+  struct json_base {
     /*
      *
      */
@@ -108,67 +112,88 @@ namespace cxx
     /*
      *
      */
-    using byte_stream = std::vector<cxx::byte>;
+    using byte_view = std::basic_string_view<cxx::byte>;
 
     /*
      *
      */
-    using byte_view = std::basic_string_view<byte_stream::value_type>;
+    struct key {
+      std::string::const_pointer const ptr;
+      std::string::size_type const size;
+      constexpr key(std::string::const_pointer x, std::string::size_type y) noexcept
+          : ptr(x), size(y)
+      {
+      }
+    };
+  };
 
+  /*
+   * all strings and containers of the tree are allocated with Allocator rebound to their value
+   * type; cxx::json uses std::allocator and cxx::pmr::json std::pmr::polymorphic_allocator.
+   * Allocators follow the standard container rules, a copy or an assignment target of
+   * cxx::pmr::json does not share the memory resource of its source.
+   */
+  template <template <typename> typename Allocator>
+  struct basic_json : json_base {
     /*
      *
      */
-    using dictionary = std::map<std::string, json>;
+    using allocator = Allocator<char>;
 
     /*
      *
      */
-    using array = std::vector<json>;
+    using byte_stream = std::vector<cxx::byte, Allocator<cxx::byte>>;
 
     /*
      *
      */
-    using alternatives = meta::
-        type_list<dictionary, std::int64_t, array, std::string, byte_stream, double, bool, null_t>;
+    using string = std::basic_string<char, std::char_traits<char>, Allocator<char>>;
 
     /*
      *
      */
-    struct key {
-      std::string::const_pointer const ptr;
-      std::string::size_type const size;
-      constexpr key(std::string::const_pointer x, std::string::size_type y) noexcept
-          : ptr(x), size(y)
-      {
-      }
-    };
+    using dictionary = cxx::
+        flat_map<string, basic_json, std::less<>, Allocator<std::pair<string, basic_json>>>;
+
+    /*
+     *
+     */
+    using array = std::vector<basic_json, Allocator<basic_json>>;
+
+    /*
+     *
+     */
+    using alternatives =
+        meta::type_list<dictionary, std::int64_t, array, string, byte_stream, double, bool, null_t>;
 
     template <typename T>
-    static constexpr auto is_alternative = json::alternatives::contains<T>;
+    static constexpr auto is_alternative = basic_json::alternatives::template contains<T>;
 
     /*
      *
      */
     template <typename T>
-    using compatibile_alternative =
-        std::conditional_t<json::is_alternative<std::decay_t<T>>,
-                           std::decay_t<T>,
-                           json::alternatives::find<traits::is_convertible_to<T>::template type>>;
+    using compatibile_alternative = std::conditional_t<
+        basic_json::is_alternative<std::decay_t<T>>,
+        std::decay_t<T>,
+        typename basic_json::alternatives::template find<
+            traits::is_convertible_to<T>::template type>>;
 
     /*
      *
      */
     template <typename T>
     static constexpr bool is_compatibile =
-        !std::is_same_v<json, std::decay_t<T>> &&
-        (json::is_alternative<std::decay_t<T>> ||
-         json::alternatives::apply<
+        !std::is_same_v<basic_json, std::decay_t<T>> &&
+        (basic_json::is_alternative<std::decay_t<T>> ||
+         basic_json::alternatives::template apply<
              traits::is_convertible_to<std::decay_t<T>>::template any_of>::value);
 
     /*
      *
      */
-    using object = json::alternatives::apply<std::variant>;
+    using object = typename basic_json::alternatives::template apply<std::variant>;
 
     object& to_object() noexcept { return storage; }
     object const& to_object() const noexcept { return storage; }
@@ -176,54 +201,62 @@ namespace cxx
     /*
      *
      */
-    template <typename T, typename = std::enable_if_t<json::is_compatibile<T>>>
-    json(T&& t) noexcept(noexcept(json::compatibile_alternative<T>(std::forward<T>(t))))
-        : storage(json::compatibile_alternative<T>(std::forward<T>(t)))
+    template <typename T, typename = std::enable_if_t<basic_json::is_compatibile<T>>>
+    basic_json(T&& t) noexcept(
+        noexcept(basic_json::compatibile_alternative<T>(std::forward<T>(t))))
+        : storage(basic_json::compatibile_alternative<T>(std::forward<T>(t)))
     {
     }
 
-    json() noexcept = default;
-    json(json const&) = default;
-    json(json&&) noexcept = default;
-    json& operator=(json const&) = default;
-    json& operator=(json&&) noexcept = default;
+    basic_json() noexcept = default;
+    basic_json(basic_json const&) = default;
+    basic_json(basic_json&&) noexcept = default;
+    basic_json& operator=(basic_json const&) = default;
+    basic_json& operator=(basic_json&&) noexcept = default;
+
+    /*
+     * past a few hundred levels nested containers are freed bottom up from an explicit stack, deep
+     * trees do not overflow
+     */
+    ~basic_json();
 
     /*
      *
      */
-    json(std::initializer_list<cxx::json::array::value_type>);
-    json& operator=(std::initializer_list<cxx::json::array::value_type>);
+    basic_json(std::initializer_list<typename basic_json::array::value_type>);
+    basic_json& operator=(std::initializer_list<typename basic_json::array::value_type>);
 
     /*
      *
      */
-    json(std::initializer_list<cxx::json::byte_stream::value_type>);
-    json& operator=(std::initializer_list<cxx::json::byte_stream::value_type>);
+    basic_json(std::initializer_list<typename basic_json::byte_stream::value_type>);
+    basic_json& operator=(std::initializer_list<typename basic_json::byte_stream::value_type>);
 
     /*
      *
      */
-    json(std::initializer_list<std::pair<json::key const, json>>);
-    json& operator=(std::initializer_list<std::pair<json::key const, json>>);
+    basic_json(std::initializer_list<std::pair<json_base::key const, basic_json>>);
+    basic_json& operator=(std::initializer_list<std::pair<json_base::key const, basic_json>>);
 
-    template <typename T, typename = std::enable_if_t<json::is_compatibile<T>>>
-    json& operator=(T&& t) noexcept(noexcept(json::compatibile_alternative<T>(std::forward<T>(t))))
+    template <typename T, typename = std::enable_if_t<basic_json::is_compatibile<T>>>
+    basic_json& operator=(T&& t) noexcept(
+        noexcept(basic_json::compatibile_alternative<T>(std::forward<T>(t))))
     {
-      storage.emplace<json::compatibile_alternative<T>>(std::forward<T>(t));
+      storage.template emplace<basic_json::compatibile_alternative<T>>(std::forward<T>(t));
       return *this;
     }
 
     /*
      *
      */
-    json& operator[](std::string const&);
-    json const& operator[](std::string const&) const;
+    basic_json& operator[](std::string const&);
+    basic_json const& operator[](std::string const&) const;
 
     /*
      *
      */
-    json& operator[](std::size_t);
-    json const& operator[](std::size_t) const;
+    basic_json& operator[](std::size_t);
+    basic_json const& operator[](std::size_t) const;
 
     /*
      *
@@ -235,6 +268,19 @@ namespace cxx
     object storage;
   };
 
+  /*
+   *
+   */
+  using json = basic_json<std::allocator>;
+
+  namespace pmr
+  {
+    /*
+     *
+     */
+    using json = basic_json<std::pmr::polymorphic_allocator>;
+  } // namespace pmr
+
   inline namespace literals
   {
     /*
@@ -254,72 +300,126 @@ namespace cxx
   /*
    *
    */
-  constexpr auto const to_object =
-      overload{[](json& x) -> json::object& { return x.to_object(); },
-               [](json const& x) -> json::object const& { return x.to_object(); }};
+  constexpr auto const to_object = [](auto& x) -> decltype(x.to_object()) {
+    return x.to_object();
+  };
 
   /*
-   *
+   * other node types, e.g. cxx::compact, take part through their get, visit
+   * and holds_alternative members
    */
   template <typename T>
   constexpr auto const get =
-      overload{[](json const& x) -> decltype(auto) { return std::get<T>(to_object(x)); },
-               [](json& x) -> decltype(auto) { return std::get<T>(to_object(x)); }};
+      overload{[](auto const& x) -> decltype(std::get<T>(to_object(x))) {
+                 return std::get<T>(to_object(x));
+               },
+               [](auto& x) -> decltype(std::get<T>(to_object(x))) {
+                 return std::get<T>(to_object(x));
+               },
+               [](auto&& x) -> decltype(x.template get<T>()) { return x.template get<T>(); }};
 
   /*
    *
    */
   constexpr auto const visit =
-      overload{[](auto&& f, json& x) -> decltype(auto) {
-                 return std::visit(std::forward<decltype(f)>(f), to_object(x));
+      overload{[](auto&& f, auto& x) -> decltype(std::visit(std::forward<decltype(f)>(f),
+                                                            x.to_object())) {
+                 return std::visit(std::forward<decltype(f)>(f), x.to_object());
                },
-               [](auto&& f, json const& x) -> decltype(auto) {
-                 return std::visit(std::forward<decltype(f)>(f), to_object(x));
+               [](auto&& f, auto&& x) -> decltype(x.visit(std::forward<decltype(f)>(f))) {
+                 return x.visit(std::forward<decltype(f)>(f));
                }};
 
   /*
    *
    */
   template <typename T>
-  constexpr auto const holds_alternative =
-      [](json const& j) -> bool { return std::holds_alternative<T>(cxx::to_object(j)); };
+  constexpr auto const holds_alternative = overload{
+      [](auto const& j) -> decltype(std::holds_alternative<T>(cxx::to_object(j))) {
+        return std::holds_alternative<T>(cxx::to_object(j));
+      },
+      [](auto const& x) -> decltype(x.template holds_alternative<T>()) {
+        return x.template holds_alternative<T>();
+      }};
+
+  template <template <typename> typename Allocator>
+  bool operator==(basic_json<Allocator> const& lhs, basic_json<Allocator> const& rhs) noexcept;
 
-  bool operator==(json const& lhs, json const& rhs) noexcept;
-  bool operator!=(json const& lhs, json const& rhs) noexcept;
+  template <template <typename> typename Allocator>
+  bool operator!=(basic_json<Allocator> const& lhs, basic_json<Allocator> const& rhs) noexcept;
 
   /*
    *
    */
-  std::string to_string(json const&);
+  struct layout {
+    /*
+     * drop the blank after ',' and ':'
+     */
+    bool compact = false;
+
+    /*
+     * when non-zero, break containers into lines indented by this many spaces per level
+     */
+    std::size_t indent = 0;
+  };
 
   /*
    *
    */
-  template <typename T>
-  auto operator==(json const& j, T const& rhs) noexcept
-      -> std::enable_if_t<json::is_compatibile<T>, bool>;
+  std::string to_string(json const&, layout = {});
+  void to_string(json const&, cxx::by_ref<std::string>, layout = {});
 
-  template <typename T>
-  auto operator==(T const& lhs, json const& rhs) noexcept
-      -> std::enable_if_t<json::is_compatibile<T>, bool>;
+  /*
+   * streams the text through a fixed size buffer instead of building it in memory
+   */
+  void write(json const&, std::ostream&, layout = {});
+  void write(json const&, int fd, layout = {});
 
-  template <typename T>
-  auto operator!=(json const& lhs, T const& rhs) noexcept
-      -> std::enable_if_t<json::is_compatibile<T>, bool>;
+  /*
+   *
+   */
+  struct parse_error : std::runtime_error {
+    using std::runtime_error::runtime_error;
+    virtual ~parse_error() = default;
+  };
 
-  template <typename T>
-  auto operator!=(T const& lhs, json const& rhs) noexcept
-      -> std::enable_if_t<json::is_compatibile<T>, bool>;
+  /*
+   *
+   */
+  json parse(std::string_view);
+  json parse(cxx::by_ref<std::string_view>);
+
+  /*
+   *
+   */
+  template <template <typename> typename Allocator, typename T>
+  auto operator==(basic_json<Allocator> const& j, T const& rhs) noexcept
+      -> std::enable_if_t<basic_json<Allocator>::template is_compatibile<T>, bool>;
+
+  template <template <typename> typename Allocator, typename T>
+  auto operator==(T const& lhs, basic_json<Allocator> const& rhs) noexcept
+      -> std::enable_if_t<basic_json<Allocator>::template is_compatibile<T>, bool>;
+
+  template <template <typename> typename Allocator, typename T>
+  auto operator!=(basic_json<Allocator> const& lhs, T const& rhs) noexcept
+      -> std::enable_if_t<basic_json<Allocator>::template is_compatibile<T>, bool>;
+
+  template <template <typename> typename Allocator, typename T>
+  auto operator!=(T const& lhs, basic_json<Allocator> const& rhs) noexcept
+      -> std::enable_if_t<basic_json<Allocator>::template is_compatibile<T>, bool>;
 } // namespace cxx
 
 /*
  *
  */
-template <typename T>
-auto ::cxx::operator==(json const& j, T const& rhs) noexcept
-    -> std::enable_if_t<json::is_compatibile<T>, bool>
+template <template <typename> typename Allocator, typename T>
+auto ::cxx::operator==(basic_json<Allocator> const& j, T const& rhs) noexcept
+    -> std::enable_if_t<basic_json<Allocator>::template is_compatibile<T>, bool>
 {
-  using type = std::conditional_t<json::is_alternative<T>, T, json::compatibile_alternative<T>>;
+  using json = basic_json<Allocator>;
+  using type = std::conditional_t<json::template is_alternative<T>,
+                                  T,
+                                  typename json::template compatibile_alternative<T>>;
   auto const func = [&rhs](auto const& lhs) -> bool {
     if constexpr (std::is_same_v<decltype(lhs), type const&>)
       return lhs == rhs;
@@ -329,23 +429,23 @@ auto ::cxx::operator==(json const& j, T const& rhs) noexcept
   return cxx::visit(func, j);
 }
 
-template <typename T>
-auto ::cxx::operator==(T const& lhs, json const& rhs) noexcept
-    -> std::enable_if_t<json::is_compatibile<T>, bool>
+template <template <typename> typename Allocator, typename T>
+auto ::cxx::operator==(T const& lhs, basic_json<Allocator> const& rhs) noexcept
+    -> std::enable_if_t<basic_json<Allocator>::template is_compatibile<T>, bool>
 {
   return rhs == lhs;
 }
 
-template <typename T>
-auto ::cxx::operator!=(json const& lhs, T const& rhs) noexcept
-    -> std::enable_if_t<json::is_compatibile<T>, bool>
+template <template <typename> typename Allocator, typename T>
+auto ::cxx::operator!=(basic_json<Allocator> const& lhs, T const& rhs) noexcept
+    -> std::enable_if_t<basic_json<Allocator>::template is_compatibile<T>, bool>
 {
   return !(lhs == rhs);
 }
 
-template <typename T>
-auto ::cxx::operator!=(T const& lhs, json const& rhs) noexcept
-    -> std::enable_if_t<json::is_compatibile<T>, bool>
+template <template <typename> typename Allocator, typename T>
+auto ::cxx::operator!=(T const& lhs, basic_json<Allocator> const& rhs) noexcept
+    -> std::enable_if_t<basic_json<Allocator>::template is_compatibile<T>, bool>
 {
   return !(lhs == rhs);
 }
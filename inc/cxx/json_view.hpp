@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cxx/json.hpp>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+
+namespace cxx
+{
+  /*
+   * Decoded document borrowing its strings, byte streams and dictionary keys from the buffer
+   * it was decoded from. Containers are owned, the buffer has to outlive the view.
+   */
+  struct json_view : json_base {
+    /*
+     * containers only, text is never allocated
+     */
+    using allocator = std::allocator<char>;
+
+    /*
+     *
+     */
+    using byte_stream = json_base::byte_view;
+
+    /*
+     *
+     */
+    using string = std::string_view;
+
+    /*
+     *
+     */
+    using dictionary = cxx::flat_map<string, json_view>;
+
+    /*
+     *
+     */
+    using array = std::vector<json_view>;
+
+    /*
+     *
+     */
+    using alternatives =
+        meta::type_list<dictionary, std::int64_t, array, string, byte_stream, double, bool, null_t>;
+
+    /*
+     *
+     */
+    using object = typename json_view::alternatives::template apply<std::variant>;
+
+    object& to_object() noexcept { return storage; }
+    object const& to_object() const noexcept { return storage; }
+
+    /*
+     *
+     */
+    template <typename T,
+              typename = std::enable_if_t<
+                  json_view::alternatives::template contains<std::decay_t<T>>>>
+    json_view(T&& t) noexcept(std::is_nothrow_constructible_v<object, T&&>)
+        : storage(std::forward<T>(t))
+    {
+    }
+
+    json_view() noexcept = default;
+
+    /*
+     * throws std::out_of_range
+     */
+    json_view const& operator[](std::string_view) const;
+    json_view const& operator[](std::size_t) const;
+
+    /*
+     *
+     */
+    std::size_t size() const noexcept;
+    bool empty() const noexcept;
+
+    /*
+     * deep copy which no longer refers to the decoded buffer
+     */
+    json to_owned() const;
+
+  private:
+    object storage;
+  };
+} // namespace cxx
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cxx/json.hpp>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace cxx
+{
+  /*
+   * Encoded document decoded on access. A lookup splits a container into the encoded slices of
+   * its items, skipping over their content; reading any other node decodes it into a cxx::json.
+   * Both results are cached, so a lazy must not be shared between threads without locking.
+   * The encoded bytes have to outlive it.
+   */
+  class lazy
+  {
+  public:
+    /*
+     *
+     */
+    using dictionary = cxx::flat_map<std::string, lazy>;
+
+    /*
+     *
+     */
+    using array = std::vector<lazy>;
+
+    /*
+     * encoded items of a container, std::monostate for other nodes
+     */
+    using items = std::variant<std::monostate, dictionary, array>;
+
+    /*
+     * format of the encoded bytes, provided by cxx::cbor and cxx::msgpack
+     */
+    struct format {
+      json (*decode)(json::byte_view);
+      items (*split)(json::byte_view, format const&);
+    };
+
+    lazy(json::byte_view x, format const& f) noexcept : bytes(x), codec(&f) {}
+
+    /*
+     * throws std::bad_variant_access if node is not a dictionary, std::out_of_range if key is
+     * missing
+     */
+    lazy const& operator[](std::string const&) const;
+
+    /*
+     * throws std::bad_variant_access if node is not an array, std::out_of_range
+     */
+    lazy const& operator[](std::size_t) const;
+
+    /*
+     * whole node, decoded once
+     */
+    json const& decoded() const;
+
+    /*
+     *
+     */
+    json::byte_view encoded() const noexcept { return bytes; }
+
+    /*
+     * T is lazy::dictionary, lazy::array or one of cxx::json alternatives, only the latter
+     * decode the node
+     */
+    template <typename T>
+    decltype(auto) get() const
+    {
+      if constexpr (std::is_same_v<T, dictionary> || std::is_same_v<T, array>)
+        return std::get<T>(parts());
+      else
+        return cxx::get<T>(decoded());
+    }
+
+    /*
+     *
+     */
+    template <typename T>
+    bool holds_alternative() const
+    {
+      if constexpr (std::is_same_v<T, dictionary> || std::is_same_v<T, json::dictionary>)
+        return std::holds_alternative<dictionary>(parts());
+      else if constexpr (std::is_same_v<T, array> || std::is_same_v<T, json::array>)
+        return std::holds_alternative<array>(parts());
+      else
+        return std::holds_alternative<std::monostate>(parts()) &&
+               cxx::holds_alternative<T>(decoded());
+    }
+
+    /*
+     *
+     */
+    template <typename F>
+    decltype(auto) visit(F&& f) const
+    {
+      return cxx::visit(std::forward<F>(f), decoded());
+    }
+
+    /*
+     * containers are only split
+     */
+    std::size_t size() const;
+    bool empty() const { return size() == 0; }
+
+  private:
+    items const& parts() const;
+
+    json::byte_view bytes;
+    format const* codec;
+    mutable std::optional<items> split;
+    mutable std::optional<json> value;
+  };
+} // namespace cxx
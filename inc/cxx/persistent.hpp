@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cxx/json.hpp>
+#include <memory>
+#include <type_traits>
+#include <variant>
+
+namespace cxx
+{
+  /*
+   * Immutable json node sharing its subtrees. Copies only bump a reference count and updates
+   * return a new node copying the modified container, the untouched items stay shared. Nodes
+   * are never modified after construction, so copies can be handed to other threads.
+   */
+  class persistent
+  {
+  public:
+    /*
+     *
+     */
+    using null_t = json::null_t;
+    static constexpr null_t null{};
+
+    /*
+     *
+     */
+    using byte_stream = json::byte_stream;
+
+    /*
+     *
+     */
+    using dictionary = cxx::flat_map<std::string, persistent>;
+
+    /*
+     *
+     */
+    using array = std::vector<persistent>;
+
+    /*
+     *
+     */
+    using object = std::
+        variant<dictionary, std::int64_t, array, std::string, byte_stream, double, bool, null_t>;
+
+    /*
+     * null does not allocate
+     */
+    persistent() noexcept = default;
+    persistent(null_t) noexcept {}
+
+    persistent(bool);
+
+    template <typename T,
+              typename = std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>>
+    persistent(T x)
+        : node(std::make_shared<object const>(std::in_place_type<std::int64_t>,
+                                              static_cast<std::int64_t>(x)))
+    {
+    }
+
+    persistent(double);
+    persistent(std::string);
+    persistent(std::string_view x) : persistent(std::string(x)) {}
+    persistent(char const* x) : persistent(std::string(x)) {}
+    persistent(byte_stream);
+    persistent(dictionary);
+    persistent(array);
+
+    /*
+     * converts whole tree
+     */
+    explicit persistent(json const&);
+
+    /*
+     *
+     */
+    object const& to_object() const noexcept;
+
+    /*
+     * throws std::bad_variant_access if node is not a dictionary, std::out_of_range if key is
+     * missing
+     */
+    persistent const& operator[](std::string const&) const;
+
+    /*
+     * throws std::bad_variant_access if node is not an array, std::out_of_range
+     */
+    persistent const& operator[](std::size_t) const;
+
+    /*
+     * copy with key set to value, throws std::bad_variant_access if node is not a dictionary
+     */
+    persistent with(std::string const& key, persistent value) const;
+
+    /*
+     * copy with item replaced by value, throws std::bad_variant_access if node is not an array
+     * and std::out_of_range
+     */
+    persistent with(std::size_t, persistent value) const;
+
+    /*
+     * copy with value appended, throws std::bad_variant_access if node is not an array
+     */
+    persistent with_appended(persistent value) const;
+
+    /*
+     * copy without key, throws std::bad_variant_access if node is not a dictionary
+     */
+    persistent without(std::string const& key) const;
+
+    /*
+     * deep copy
+     */
+    json to_json() const;
+
+    /*
+     *
+     */
+    std::size_t size() const noexcept;
+    bool empty() const noexcept;
+
+    /*
+     * nodes sharing their content compare equal without visiting it
+     */
+    friend bool operator==(persistent const&, persistent const&) noexcept;
+    friend bool operator!=(persistent const& lhs, persistent const& rhs) noexcept
+    {
+      return !(lhs == rhs);
+    }
+
+  private:
+    std::shared_ptr<object const> node;
+  };
+
+  bool operator==(persistent const&, persistent const&) noexcept;
+} // namespace cxx
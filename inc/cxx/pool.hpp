@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+
+namespace cxx
+{
+  /*
+   * Memory resource recycling freed blocks through free lists, one per power of two size up to
+   * max_block_size. Larger or over-aligned blocks and misses go to the upstream resource; each
+   * list caches at most max_cached blocks, the rest is returned upstream. Not synchronized, the
+   * thread local pool must only see blocks of its own thread.
+   */
+  class pool : public std::pmr::memory_resource
+  {
+  public:
+    /*
+     *
+     */
+    static constexpr std::size_t const max_block_size = 4096;
+    static constexpr std::size_t const default_max_cached = 4096;
+
+    explicit pool(std::size_t max_cached = default_max_cached,
+                  std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    pool(pool const&) = delete;
+    pool& operator=(pool const&) = delete;
+    ~pool() override;
+
+    /*
+     * pool of the calling thread, documents allocated from it have to be destroyed on the same
+     * thread
+     */
+    static pool& local();
+
+    /*
+     * returns all cached blocks upstream
+     */
+    void release() noexcept;
+
+    /*
+     * allocations served from and past the free lists
+     */
+    std::size_t hits() const noexcept { return served; }
+    std::size_t misses() const noexcept { return missed; }
+
+  private:
+    struct node {
+      node* next;
+    };
+
+    struct bin {
+      node* head = nullptr;
+      std::size_t cached = 0;
+    };
+
+    static constexpr std::size_t const min_block_size = 16;
+    static constexpr std::size_t const bin_count = 9;
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override;
+
+    std::size_t const max_cached;
+    std::pmr::memory_resource* const upstream;
+    std::array<bin, bin_count> bins;
+    std::size_t served = 0;
+    std::size_t missed = 0;
+  };
+} // namespace cxx
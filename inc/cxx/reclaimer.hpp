@@ -0,0 +1,57 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cxx/json.hpp>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cxx
+{
+  /*
+   * Frees documents on a background thread. The thread takes all queued documents at once and
+   * frees them outside of the lock; once capacity documents are queued, defer blocks until the
+   * thread catches up. Destruction frees the remaining documents and joins the thread.
+   */
+  class reclaimer
+  {
+  public:
+    /*
+     *
+     */
+    static constexpr std::size_t const default_capacity = 64;
+
+    explicit reclaimer(std::size_t capacity = default_capacity);
+    reclaimer(reclaimer const&) = delete;
+    reclaimer& operator=(reclaimer const&) = delete;
+    ~reclaimer();
+
+    /*
+     * leaves x null, blocks while the queue is full
+     */
+    void defer(json&& x);
+
+    /*
+     * blocks until every document deferred so far is freed
+     */
+    void drain();
+
+  private:
+    void run();
+
+    std::size_t const capacity;
+    std::mutex mutex;
+    std::condition_variable queued;
+    std::condition_variable freed;
+    std::vector<json> queue;
+    std::size_t in_flight = 0;
+    bool stopping = false;
+    std::thread worker;
+  };
+
+  /*
+   * defers to a process wide reclaimer, started on first use
+   */
+  void defer_destroy(json&& x);
+} // namespace cxx
@@ -0,0 +1,360 @@
+#pragma once
+
+#include <cxx/json.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace cxx
+{
+  /*
+   * Read-only decoded document laid out as one array of tagged 64 bit words plus a buffer
+   * holding the text of strings and byte streams. The tag lives in the top byte of a word.
+   * Containers start with [tag|end][count], where end indexes the word following their last
+   * item, so a whole subtree is skipped in one step. Dictionary items are key and value
+   * pairs. Integers, doubles, strings and byte streams take a second word holding the value,
+   * or the size of the text whose offset is in the first word.
+   */
+  class tape
+  {
+  public:
+    using word = std::uint64_t;
+    using null_t = json::null_t;
+    using byte_view = json::byte_view;
+
+    /*
+     * same order as cxx::json alternatives
+     */
+    enum class kind : std::uint8_t {
+      dictionary,
+      integer,
+      array,
+      string,
+      bytes,
+      real,
+      boolean,
+      null
+    };
+
+    class value;
+    class array;
+    class dictionary;
+    class builder;
+
+    /*
+     *
+     */
+    value root() const noexcept;
+
+    /*
+     *
+     */
+    std::vector<word> const& words() const noexcept { return tags; }
+    std::string_view strings() const noexcept { return text; }
+
+  private:
+    static constexpr unsigned const shift = 56;
+    static constexpr word const payload_mask = (word(1) << shift) - 1;
+
+    static kind kind_of(word x) noexcept { return static_cast<kind>(x >> shift); }
+    static word payload_of(word x) noexcept { return x & payload_mask; }
+
+    std::vector<word> tags;
+    std::string text;
+  };
+
+  /*
+   * cheap to copy handle on a single node, valid while its tape is alive and unchanged
+   */
+  class tape::value
+  {
+  public:
+    /*
+     *
+     */
+    kind type() const noexcept { return kind_of(doc->tags[index]); }
+
+    /*
+     * T is one of tape::dictionary, std::int64_t, tape::array, std::string_view, byte_view,
+     * double, bool or null_t
+     */
+    template <typename T>
+    bool holds_alternative() const noexcept
+    {
+      return type() == value::tag_of<T>();
+    }
+
+    /*
+     * throws std::bad_variant_access if other alternative is held
+     */
+    template <typename T>
+    T get() const;
+
+    /*
+     *
+     */
+    template <typename F>
+    decltype(auto) visit(F&& f) const;
+
+    /*
+     * throws std::out_of_range if key is missing
+     */
+    value operator[](std::string_view key) const;
+    value operator[](std::size_t) const;
+
+    /*
+     * number of items of containers, length of strings and byte streams, 0 for null and 1
+     * otherwise
+     */
+    std::size_t size() const noexcept;
+    bool empty() const noexcept { return size() == 0; }
+
+  private:
+    friend class tape;
+    friend class tape::array;
+    friend class tape::dictionary;
+
+    value(tape const* t, std::size_t i) noexcept : doc(t), index(i) {}
+
+    template <typename T>
+    static constexpr kind tag_of() noexcept;
+
+    word payload() const noexcept { return payload_of(doc->tags[index]); }
+    word second() const noexcept { return doc->tags[index + 1]; }
+    std::string_view view() const noexcept
+    {
+      return std::string_view(doc->text.data() + payload(), second());
+    }
+
+    /*
+     * index of the word following this node
+     */
+    std::size_t skip() const noexcept;
+
+    tape const* doc;
+    std::size_t index;
+  };
+
+  /*
+   *
+   */
+  class tape::array
+  {
+  public:
+    class iterator
+    {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = tape::value;
+      using difference_type = std::ptrdiff_t;
+      using pointer = void;
+      using reference = tape::value;
+
+      iterator() = default;
+      tape::value operator*() const noexcept { return tape::value(doc, index); }
+      iterator& operator++() noexcept
+      {
+        index = tape::value(doc, index).skip();
+        return *this;
+      }
+      iterator operator++(int) noexcept
+      {
+        auto ret = *this;
+        ++*this;
+        return ret;
+      }
+      bool operator==(iterator const& other) const noexcept { return index == other.index; }
+      bool operator!=(iterator const& other) const noexcept { return index != other.index; }
+
+    private:
+      friend class tape::array;
+      iterator(tape const* t, std::size_t i) noexcept : doc(t), index(i) {}
+      tape const* doc = nullptr;
+      std::size_t index = 0;
+    };
+
+    iterator begin() const noexcept { return iterator(self.doc, self.index + 2); }
+    iterator end() const noexcept { return iterator(self.doc, self.skip()); }
+    std::size_t size() const noexcept { return self.second(); }
+    bool empty() const noexcept { return size() == 0; }
+
+    /*
+     * walks over preceding items, throws std::out_of_range
+     */
+    tape::value operator[](std::size_t) const;
+
+  private:
+    friend class tape::value;
+    explicit array(tape::value x) noexcept : self(x) {}
+    tape::value self;
+  };
+
+  /*
+   * items keep the order in which they were encoded, lookup is linear
+   */
+  class tape::dictionary
+  {
+  public:
+    class iterator
+    {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = std::pair<std::string_view, tape::value>;
+      using difference_type = std::ptrdiff_t;
+      using pointer = void;
+      using reference = value_type;
+
+      iterator() = default;
+      value_type operator*() const noexcept
+      {
+        tape::value const key(doc, index);
+        return {key.view(), tape::value(doc, index + 2)};
+      }
+      iterator& operator++() noexcept
+      {
+        index = tape::value(doc, index + 2).skip();
+        return *this;
+      }
+      iterator operator++(int) noexcept
+      {
+        auto ret = *this;
+        ++*this;
+        return ret;
+      }
+      bool operator==(iterator const& other) const noexcept { return index == other.index; }
+      bool operator!=(iterator const& other) const noexcept { return index != other.index; }
+
+    private:
+      friend class tape::dictionary;
+      iterator(tape const* t, std::size_t i) noexcept : doc(t), index(i) {}
+      tape const* doc = nullptr;
+      std::size_t index = 0;
+    };
+
+    iterator begin() const noexcept { return iterator(self.doc, self.index + 2); }
+    iterator end() const noexcept { return iterator(self.doc, self.skip()); }
+    std::size_t size() const noexcept { return self.second(); }
+    bool empty() const noexcept { return size() == 0; }
+
+    /*
+     *
+     */
+    iterator find(std::string_view) const noexcept;
+    bool contains(std::string_view key) const noexcept { return find(key) != end(); }
+
+    /*
+     * throws std::out_of_range
+     */
+    tape::value operator[](std::string_view) const;
+
+  private:
+    friend class tape::value;
+    explicit dictionary(tape::value x) noexcept : self(x) {}
+    tape::value self;
+  };
+
+  inline auto tape::root() const noexcept -> value
+  {
+    return value(this, 0);
+  }
+
+  inline std::size_t tape::value::skip() const noexcept
+  {
+    switch (type())
+    {
+      case kind::dictionary:
+      case kind::array:
+        return payload();
+      case kind::integer:
+      case kind::string:
+      case kind::bytes:
+      case kind::real:
+        return index + 2;
+      default:
+        return index + 1;
+    }
+  }
+
+  template <typename T>
+  constexpr auto tape::value::tag_of() noexcept -> kind
+  {
+    if constexpr (std::is_same_v<T, tape::dictionary>) return kind::dictionary;
+    else if constexpr (std::is_same_v<T, std::int64_t>)
+      return kind::integer;
+    else if constexpr (std::is_same_v<T, tape::array>)
+      return kind::array;
+    else if constexpr (std::is_same_v<T, std::string_view>)
+      return kind::string;
+    else if constexpr (std::is_same_v<T, byte_view>)
+      return kind::bytes;
+    else if constexpr (std::is_same_v<T, double>)
+      return kind::real;
+    else if constexpr (std::is_same_v<T, bool>)
+      return kind::boolean;
+    else
+    {
+      static_assert(std::is_same_v<T, null_t>, "not an alternative of cxx::tape::value");
+      return kind::null;
+    }
+  }
+
+  template <typename T>
+  T tape::value::get() const
+  {
+    if (!holds_alternative<T>()) throw std::bad_variant_access();
+    if constexpr (std::is_same_v<T, tape::dictionary> || std::is_same_v<T, tape::array>)
+      return T(*this);
+    else if constexpr (std::is_same_v<T, std::int64_t>)
+      return static_cast<std::int64_t>(second());
+    else if constexpr (std::is_same_v<T, std::string_view>)
+      return view();
+    else if constexpr (std::is_same_v<T, byte_view>)
+    {
+      auto const text = view();
+      return byte_view(reinterpret_cast<cxx::byte const*>(text.data()), std::size(text));
+    }
+    else if constexpr (std::is_same_v<T, double>)
+    {
+      double ret;
+      auto const bits = second();
+      static_assert(sizeof(ret) == sizeof(bits));
+      std::memcpy(&ret, &bits, sizeof(ret));
+      return ret;
+    }
+    else if constexpr (std::is_same_v<T, bool>)
+      return payload() != 0;
+    else
+      return null_t{};
+  }
+
+  template <typename F>
+  decltype(auto) tape::value::visit(F&& f) const
+  {
+    switch (type())
+    {
+      case kind::dictionary:
+        return f(get<tape::dictionary>());
+      case kind::integer:
+        return f(get<std::int64_t>());
+      case kind::array:
+        return f(get<tape::array>());
+      case kind::string:
+        return f(get<std::string_view>());
+      case kind::bytes:
+        return f(get<byte_view>());
+      case kind::real:
+        return f(get<double>());
+      case kind::boolean:
+        return f(get<bool>());
+      case kind::null:
+        break;
+    }
+    return f(null_t{});
+  }
+} // namespace cxx
@@ -0,0 +1,60 @@
+#include "inc/cxx/arena.hpp"
+#include <algorithm>
+#include <numeric>
+
+::cxx::arena::arena(std::size_t block_size)
+{
+  block_size = std::max<std::size_t>(block_size, alignof(std::max_align_t));
+  blocks.push_back(block{std::unique_ptr<std::byte[]>(new std::byte[block_size]), block_size});
+  reset();
+}
+
+::cxx::arena::~arena() = default;
+
+void ::cxx::arena::reset() noexcept
+{
+  current = 0;
+  before = 0;
+  cursor = blocks.front().data.get();
+  limit = cursor + blocks.front().size;
+}
+
+auto ::cxx::arena::used() const noexcept -> std::size_t
+{
+  return before + static_cast<std::size_t>(cursor - blocks[current].data.get());
+}
+
+auto ::cxx::arena::capacity() const noexcept -> std::size_t
+{
+  return std::accumulate(std::begin(blocks), std::end(blocks), std::size_t(0),
+                         [](std::size_t sum, block const& x) { return sum + x.size; });
+}
+
+[[gnu::flatten]] void* ::cxx::arena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+  void* ptr = cursor;
+  auto space = static_cast<std::size_t>(limit - cursor);
+  if (std::align(alignment, bytes, ptr, space) == nullptr) return grow(bytes, alignment);
+  cursor = static_cast<std::byte*>(ptr) + bytes;
+  return ptr;
+}
+
+bool ::cxx::arena::do_is_equal(std::pmr::memory_resource const& other) const noexcept
+{
+  return this == &other;
+}
+
+void* ::cxx::arena::grow(std::size_t bytes, std::size_t alignment)
+{
+  auto const needed = bytes + alignment;
+  before += static_cast<std::size_t>(cursor - blocks[current].data.get());
+  while (++current < std::size(blocks) && blocks[current].size < needed) continue;
+  if (current == std::size(blocks))
+  {
+    auto const size = std::max(2 * blocks.back().size, needed);
+    blocks.push_back(block{std::unique_ptr<std::byte[]>(new std::byte[size]), size});
+  }
+  cursor = blocks[current].data.get();
+  limit = cursor + blocks[current].size;
+  return do_allocate(bytes, alignment);
+}
@@ -0,0 +1,66 @@
+#include "inc/cxx/byte_chain.hpp"
+#include <algorithm>
+
+namespace
+{
+  /*
+   * room for the largest header the encoders reserve at once
+   */
+  constexpr std::size_t const min_segment_size = 0x40;
+} // namespace
+
+::cxx::byte_chain::byte_chain(std::size_t size, std::size_t reference)
+    : segment_size(std::max(size, min_segment_size)), min_reference(reference)
+{
+}
+
+auto ::cxx::byte_chain::flatten() const -> json::byte_stream
+{
+  json::byte_stream ret;
+  ret.reserve(total);
+  for (auto const& x : pieces)
+  {
+    auto const* first = static_cast<cxx::byte const*>(x.iov_base);
+    ret.insert(std::end(ret), first, first + x.iov_len);
+  }
+  return ret;
+}
+
+void ::cxx::byte_chain::clear() noexcept
+{
+  pieces.clear();
+  total = 0;
+  used = 0;
+  mark = last = nullptr;
+}
+
+auto ::cxx::byte_chain::open(std::size_t n) -> std::pair<cxx::byte*, cxx::byte*>
+{
+  if (static_cast<std::size_t>(last - mark) < n || used == 0)
+  {
+    if (used == std::size(segments))
+      segments.emplace_back(new cxx::byte[segment_size]);
+    mark = segments[used++].get();
+    last = mark + segment_size;
+  }
+  return {mark, last};
+}
+
+void ::cxx::byte_chain::close(cxx::byte* end)
+{
+  auto const n = static_cast<std::size_t>(end - mark);
+  if (n == 0) return;
+  if (!std::empty(pieces) &&
+      static_cast<cxx::byte*>(pieces.back().iov_base) + pieces.back().iov_len == mark)
+    pieces.back().iov_len += n;
+  else
+    pieces.push_back({mark, n});
+  total += n;
+  mark = end;
+}
+
+void ::cxx::byte_chain::reference(cxx::byte const* data, std::size_t n)
+{
+  pieces.push_back({const_cast<cxx::byte*>(data), n});
+  total += n;
+}
@@ -1,6 +1,9 @@
 #include "inc/cxx/cbor.hpp"
 #include "src/cbor/initial_byte.hpp"
 #include "src/codec.hpp"
+#include "src/json/reuse.hpp"
+#include "src/lazy/skip.hpp"
+#include "src/tape/builder.hpp"
 #include <algorithm>
 #include <list>
 #include <arpa/inet.h>
@@ -184,9 +187,10 @@ namespace
   template <typename Stream, typename Sink>
   [[gnu::flatten]] void merge_to(std::list<cxx::json::byte_view> chunks,
                                  std::size_t length,
-                                 Sink sink)
+                                 Sink sink,
+                                 typename Stream::allocator_type const& alloc = {})
   {
-    Stream stream;
+    Stream stream(alloc);
     stream.reserve(length);
     for (auto const& item : chunks)
     {
@@ -213,35 +217,60 @@ namespace
     return parse(tag<initial_byte::type::bytes>, byte, bytes, adapter);
   }
 
-  template <typename T>
-  [[gnu::flatten]] auto emplace_to(cxx::by_ref<T> target, std::string_view key = std::string_view())
+  template <typename Json, typename T>
+  [[gnu::flatten]] auto emplace_to_tree(cxx::by_ref<T> target,
+                                        typename Json::allocator const& alloc,
+                                        std::string_view key)
   {
-    using key_type = cxx::json::dictionary::key_type;
-    auto impl = [ref = cxx::by_ref(target), key](auto&& x) {
+    auto impl = [ref = cxx::by_ref(target), alloc, key](auto&& x) {
       (void)key;
-      if constexpr (std::is_same_v<T, cxx::json::array>)
-      { ref->emplace_back(std::forward<decltype(x)>(x)); }
-      else if constexpr (std::is_same_v<T, cxx::json::dictionary>)
+      auto&& value = ::cxx::codec::own<Json>(std::forward<decltype(x)>(x), alloc);
+      if constexpr (std::is_same_v<T, typename Json::array>)
+      { ref->emplace_back(std::forward<decltype(value)>(value)); }
+      else if constexpr (std::is_same_v<T, typename Json::dictionary>)
       {
-        ref->try_emplace(key_type(key), std::forward<decltype(x)>(x));
+        ref->try_emplace(::cxx::codec::own<Json>(key, alloc),
+                         std::forward<decltype(value)>(value));
       }
-      else if constexpr (std::is_same_v<T, cxx::json>)
+      else if constexpr (std::is_same_v<T, Json>)
       {
-        ref.get() = std::forward<decltype(x)>(x);
+        ref.get() = std::forward<decltype(value)>(value);
       }
       else
       {
         throw 1;
       }
     };
-    return cxx::overload{
-        [impl](cxx::json::byte_view bytes) {
-          impl(cxx::json::byte_stream(bytes.data(), bytes.data() + std::size(bytes)));
+    auto const adapter = cxx::overload{
+        [impl, alloc](std::list<cxx::json::byte_view> chunks, std::size_t length) {
+          if constexpr (::cxx::codec::borrows<Json>)
+            throw cxx::cbor::unsupported("indefinite-length byte string can not be borrowed");
+          else
+            merge_to<typename Json::byte_stream>(chunks, length, impl, alloc);
         },
-        [impl](std::list<cxx::json::byte_view> chunks, std::size_t length) {
-          merge_to<cxx::json::byte_stream>(chunks, length, impl);
+        [impl](std::string&& text) {
+          if constexpr (::cxx::codec::borrows<Json>)
+            throw cxx::cbor::unsupported("indefinite-length string can not be borrowed");
+          else
+            impl(std::move(text));
         },
         impl};
+    return ::cxx::codec::sink<Json, std::decay_t<decltype(adapter)>>{adapter, alloc};
+  }
+
+  template <typename Json, typename T>
+  [[gnu::flatten]] auto emplace_to(cxx::by_ref<T> target,
+                                   typename Json::allocator const& alloc,
+                                   std::string_view key = std::string_view())
+  {
+    if constexpr (std::is_same_v<Json, cxx::detail::tape_json>)
+      return cxx::detail::tape_sink(cxx::by_ref(target), alloc, key);
+    else if constexpr (std::is_same_v<Json, cxx::detail::skip_json>)
+      return cxx::detail::skip_sink(cxx::by_ref(target));
+    else if constexpr (std::is_same_v<Json, cxx::detail::reuse_json>)
+      return cxx::detail::reuse_sink(cxx::by_ref(target), key);
+    else
+      return emplace_to_tree<Json>(cxx::by_ref(target), alloc, key);
   }
 
   template <typename Collection, typename Sink, typename Collector>
@@ -252,7 +281,7 @@ namespace
                                Collector collector)
   {
     if (--level == 0) throw cxx::cbor::unsupported("nesting level exceeds implementation limit");
-    Collection col;
+    Collection col(sink.alloc);
     if (cxx::detail::cbor::initial(byte)->additional == initial_byte::value::indefinite)
     {
       auto const sentinel = [](cxx::json::byte_view data) {
@@ -290,12 +319,42 @@ namespace
                              Sink sink,
                              std::size_t level)
   {
-    auto const collector = [](cxx::by_ref<cxx::json::byte_view> data,
-                              cxx::by_ref<cxx::json::array> collection, auto nesting) {
-      data.get() =
-          parse(data.c_ref(), emplace_to<cxx::json::array>(cxx::by_ref(collection)), nesting);
+    using json = typename Sink::json_type;
+    auto const collector = [alloc = sink.alloc](cxx::by_ref<cxx::json::byte_view> data,
+                                                cxx::by_ref<typename json::array> collection,
+                                                auto nesting) {
+      data.get() = parse(data.c_ref(),
+                         emplace_to<json, typename json::array>(cxx::by_ref(collection), alloc),
+                         nesting);
     };
-    return collect<cxx::json::array>(byte, bytes, sink, level, collector);
+    return collect<typename json::array>(byte, bytes, sink, level, collector);
+  }
+
+  /*
+   * indefinite-length keys are merged into storage
+   */
+  template <typename Json>
+  std::string_view read_key(cxx::by_ref<cxx::json::byte_view> data,
+                            cxx::by_ref<std::string> storage)
+  {
+    if (std::size(data.c_ref()) < 2)
+      throw cxx::cbor::truncation_error("not enough data to decode dictionary key");
+    auto const init = data->front();
+    data->remove_prefix(1);
+    if (cxx::detail::cbor::initial(init)->major != initial_byte::type::unicode)
+      throw cxx::cbor::unsupported(
+          "dictionary keys of type different thant unicode are not supported");
+    std::string_view key;
+    auto const to_key = cxx::overload{[&key](std::string_view x) { key = x; },
+                                      [&key, &storage](std::string&& x) {
+                                        if constexpr (::cxx::codec::borrows<Json>)
+                                          throw cxx::cbor::unsupported(
+                                              "indefinite-length key can not be borrowed");
+                                        storage.get() = std::move(x);
+                                        key = storage.c_ref();
+                                      }};
+    data = parse(tag<initial_byte::type::unicode>, init, data.c_ref(), to_key);
+    return key;
   }
 
   template <typename Sink>
@@ -305,22 +364,18 @@ namespace
                              Sink sink,
                              std::size_t level)
   {
-    auto const collector = [](cxx::by_ref<cxx::json::byte_view> data,
-                              cxx::by_ref<cxx::json::dictionary> collection, auto nesting) {
-      if (std::size(data.c_ref()) < 2)
-        throw cxx::cbor::truncation_error("not enough data to decode dictionary key");
-      auto const init = data->front();
-      data->remove_prefix(1);
-      if (cxx::detail::cbor::initial(init)->major != initial_byte::type::unicode)
-        throw cxx::cbor::unsupported(
-            "dictionary keys of type different thant unicode are not supported");
-      std::string_view key;
-      data = parse(tag<initial_byte::type::unicode>, init, data.c_ref(),
-                   [&key](std::string_view x) { key = x; });
-      data = parse(data.c_ref(), emplace_to<cxx::json::dictionary>(cxx::by_ref(collection), key),
-                   nesting);
+    using json = typename Sink::json_type;
+    auto const collector = [alloc = sink.alloc](cxx::by_ref<cxx::json::byte_view> data,
+                                                cxx::by_ref<typename json::dictionary> collection,
+                                                auto nesting) {
+      std::string merged;
+      auto const key = read_key<json>(cxx::by_ref(data), cxx::by_ref(merged));
+      data = parse(
+          data.c_ref(),
+          emplace_to<json, typename json::dictionary>(cxx::by_ref(collection), alloc, key),
+          nesting);
     };
-    return collect<cxx::json::dictionary>(byte, bytes, sink, level, collector);
+    return collect<typename json::dictionary>(byte, bytes, sink, level, collector);
   }
 
   template <typename T>
@@ -416,6 +471,275 @@ namespace
         throw cxx::cbor::unsupported("decoding given type is not yet supported");
     }
   }
+  /*
+   * size of the initial byte and the argument following it
+   */
+  std::size_t head_size(cxx::byte byte) noexcept
+  {
+    auto const additional = cxx::detail::cbor::initial(byte)->additional;
+    if (additional < initial_byte::value::one_byte ||
+        additional > initial_byte::value::eigth_bytes)
+      return 1;
+    return 1 + (1u << (additional - initial_byte::value::one_byte));
+  }
+
+  std::size_t argument(cxx::json::byte_view head)
+  {
+    std::size_t n = 0;
+    parse(tag<initial_byte::type::positive>, head.front(), head.substr(1),
+          [&n](std::int64_t x) { n = static_cast<std::size_t>(x); });
+    return n;
+  }
+
+  /*
+   * encoded size of the scalar, string or byte stream at offset
+   */
+  std::size_t extent(cxx::by_ref<::cxx::codec::segments> in, std::size_t offset = 0)
+  {
+    auto const front = in->peek(offset, 1);
+    if (std::empty(front)) throw cxx::cbor::truncation_error("not enough data to decode json");
+    auto const byte = front.front();
+    auto const major = cxx::detail::cbor::initial(byte)->major;
+    auto const size = head_size(byte);
+    if (major != initial_byte::type::bytes && major != initial_byte::type::unicode) return size;
+    auto at = offset + 1;
+    if (cxx::detail::cbor::initial(byte)->additional == initial_byte::value::indefinite)
+      for (;;)
+      {
+        auto const next = in->peek(at, 1);
+        if (std::empty(next))
+          throw cxx::cbor::truncation_error("break byte missing for indefinite-length collection");
+        if (next.front() == std::byte(0xff)) return at + 1 - offset;
+        auto const head = in->peek(at, head_size(next.front()));
+        if (std::empty(head))
+          throw cxx::cbor::truncation_error("not enough data to decode byte_stream");
+        at += std::size(head) + argument(head);
+        if (at > in->size())
+          throw cxx::cbor::truncation_error("not enough data to decode byte_stream");
+      }
+    auto const head = in->peek(offset, size);
+    if (std::empty(head)) throw cxx::cbor::truncation_error("not enough data to decode json");
+    return size + argument(head);
+  }
+
+  /*
+   * size of the item at the front of bytes, 0 if it does not end within them or has to be
+   * looked at by parse; only the heads are read
+   */
+  std::size_t span(cxx::json::byte_view bytes) noexcept
+  {
+    constexpr auto const indefinite = std::numeric_limits<std::size_t>::max();
+    std::size_t left[cxx::cbor::max_nesting + 1] = {1};
+    std::size_t depth = 0;
+    std::size_t at = 0;
+    for (;;)
+    {
+      while (left[depth] == 0)
+      {
+        if (depth == 0) return at;
+        --depth;
+      }
+      if (at == std::size(bytes)) return 0;
+      auto const byte = bytes[at];
+      if (left[depth] != indefinite)
+        --left[depth];
+      else if (byte == std::byte(0xff))
+      {
+        ++at;
+        left[depth] = 0;
+        continue;
+      }
+      auto const head = head_size(byte);
+      if (std::size(bytes) - at < head) return 0;
+      auto const additional = cxx::detail::cbor::initial(byte)->additional;
+      std::uint64_t arg = additional;
+      if (head > 1)
+      {
+        arg = 0;
+        for (std::size_t i = 1; i != head; ++i)
+          arg = (arg << 8) | static_cast<::cxx::codec::numbyte>(bytes[at + i]);
+      }
+      else if (additional > initial_byte::value::max_insitu && additional != initial_byte::value::indefinite)
+        return 0;
+      at += head;
+      auto const open = additional == initial_byte::value::indefinite;
+      switch (cxx::detail::cbor::initial(byte)->major)
+      {
+        case initial_byte::type::bytes:
+        case initial_byte::type::unicode:
+          if (!open)
+          {
+            if (std::size(bytes) - at < arg) return 0;
+            at += arg;
+            break;
+          }
+          [[fallthrough]];
+        case initial_byte::type::array:
+        case initial_byte::type::dictionary:
+          if (depth == cxx::cbor::max_nesting || (!open && arg > cxx::cbor::max_size)) return 0;
+          left[++depth] = open ? indefinite
+                               : arg << (cxx::detail::cbor::initial(byte)->major ==
+                                         initial_byte::type::dictionary);
+          break;
+        default:
+          break;
+      }
+    }
+  }
+
+  /*
+   * decodes from a sequence of buffers: an item lying in the first one is parsed in place,
+   * containers straddling two are walked here and any other item is copied together. An item
+   * starting further than reach from the end of the buffer is parsed without looking for its
+   * end first; reach is twice the size of its largest sibling so far.
+   */
+  template <typename Sink>
+  void gather(cxx::by_ref<::cxx::codec::segments> in,
+              Sink sink,
+              std::size_t level,
+              std::size_t reach = 0)
+  {
+    auto const whole = in->peek(0, in->contiguous());
+    auto const direct = [&] { in->skip(std::size(whole) - std::size(parse(whole, sink, level))); };
+    if (std::size(whole) == in->size()) return direct();
+    if (reach != 0 && std::size(whole) > reach)
+    {
+      try
+      {
+        return direct();
+      }
+      catch (cxx::cbor::truncation_error const&)
+      {
+      }
+    }
+    else if (span(whole) != 0)
+      return direct();
+    auto const front = in->peek(0, 1);
+    if (std::empty(front)) throw cxx::cbor::truncation_error("not enough data to decode json");
+    auto const byte = front.front();
+    auto const major = cxx::detail::cbor::initial(byte)->major;
+    if (major != initial_byte::type::array && major != initial_byte::type::dictionary)
+    {
+      auto const size = extent(cxx::by_ref(in));
+      auto const item = in->peek(0, size);
+      if (std::empty(item)) throw cxx::cbor::truncation_error("not enough data to decode json");
+      parse(item, sink, level);
+      in->skip(size);
+      return;
+    }
+    if (--level == 0) throw cxx::cbor::unsupported("nesting level exceeds implementation limit");
+    auto const indefinite =
+        cxx::detail::cbor::initial(byte)->additional == initial_byte::value::indefinite;
+    std::size_t count = 0;
+    if (indefinite)
+      in->skip(1);
+    else
+    {
+      auto const head = in->peek(0, head_size(byte));
+      if (std::empty(head)) throw cxx::cbor::truncation_error("not enough data to decode json");
+      count = argument(head);
+      if (count > cxx::cbor::max_size)
+        throw cxx::cbor::unsupported("number of elements exceeds implementation limit");
+      in->skip(std::size(head));
+    }
+    std::size_t seen = 0;
+    auto const more = [&in, indefinite, count, &seen] {
+      if (!indefinite) return seen++ < count;
+      auto const next = in->peek(0, 1);
+      if (std::empty(next))
+        throw cxx::cbor::truncation_error("break byte missing for indefinite-length collection");
+      if (next.front() == std::byte(0xff))
+      {
+        in->skip(1);
+        return false;
+      }
+      if (seen++ == cxx::cbor::max_size)
+        throw cxx::cbor::unsupported("number of elements exceeds implementation limit");
+      return true;
+    };
+    std::size_t largest = 0;
+    auto const item = [&in, level, &largest](auto target) {
+      auto const left = in->size();
+      gather(cxx::by_ref(in), target, level, 2 * largest);
+      largest = std::max(largest, left - in->size());
+    };
+    using json = typename Sink::json_type;
+    if (major == initial_byte::type::array)
+    {
+      typename json::array col(sink.alloc);
+      if constexpr (has_reserve_v<typename json::array>) col.reserve(count);
+      while (more()) item(emplace_to<json, typename json::array>(cxx::by_ref(col), sink.alloc));
+      sink(std::move(col));
+      return;
+    }
+    typename json::dictionary col(sink.alloc);
+    if constexpr (has_reserve_v<typename json::dictionary>) col.reserve(count);
+    while (more())
+    {
+      auto const size = extent(cxx::by_ref(in));
+      auto data = in->peek(0, size + 1);
+      std::string merged;
+      auto key = read_key<json>(cxx::by_ref(data), cxx::by_ref(merged));
+      if (size + 1 > in->contiguous() && key.data() != merged.data())
+        key = merged.assign(key.data(), std::size(key));
+      in->skip(size);
+      item(emplace_to<json, typename json::dictionary>(cxx::by_ref(col), sink.alloc, key));
+    }
+    sink(std::move(col));
+  }
+
+  /*
+   * encoded node found at the front of bytes
+   */
+  cxx::json::byte_view slice(cxx::by_ref<cxx::json::byte_view> bytes,
+                             std::size_t level = cxx::cbor::max_nesting)
+  {
+    auto const first = bytes.c_ref();
+    cxx::detail::skipped node(std::allocator<char>{});
+    bytes.get() = parse(first, emplace_to<cxx::detail::skip_json>(cxx::by_ref(node), {}), level);
+    return first.substr(0, std::size(first) - std::size(bytes.c_ref()));
+  }
+
+  cxx::json decode_node(cxx::json::byte_view bytes)
+  {
+    return cxx::cbor::decode(cxx::by_ref(bytes));
+  }
+
+  cxx::lazy::items split(cxx::json::byte_view bytes, cxx::lazy::format const& format)
+  {
+    if (std::empty(bytes)) throw cxx::cbor::truncation_error("not enough data to decode json");
+    auto const byte = bytes.front();
+    bytes.remove_prefix(1);
+    cxx::lazy::items ret;
+    auto const assign = [&ret](auto&& x) { ret = std::forward<decltype(x)>(x); };
+    auto const sink = ::cxx::codec::sink<cxx::json, std::decay_t<decltype(assign)>>{assign, {}};
+    switch (cxx::detail::cbor::initial(byte)->major)
+    {
+      case initial_byte::type::array:
+        collect<cxx::lazy::array>(
+            byte, bytes, sink, cxx::cbor::max_nesting,
+            [&format](cxx::by_ref<cxx::json::byte_view> data,
+                      cxx::by_ref<cxx::lazy::array> collection, std::size_t level) {
+              collection->emplace_back(slice(cxx::by_ref(data), level), format);
+            });
+        break;
+      case initial_byte::type::dictionary:
+        collect<cxx::lazy::dictionary>(
+            byte, bytes, sink, cxx::cbor::max_nesting,
+            [&format](cxx::by_ref<cxx::json::byte_view> data,
+                      cxx::by_ref<cxx::lazy::dictionary> collection, std::size_t level) {
+              std::string merged;
+              auto const key = read_key<cxx::json>(cxx::by_ref(data), cxx::by_ref(merged));
+              collection->try_emplace(std::string(key), slice(cxx::by_ref(data), level), format);
+            });
+        break;
+      default:
+        break;
+    }
+    return ret;
+  }
+
+  cxx::lazy::format const lazy_format = {&decode_node, &split};
 } // namespace
 
 auto ::cxx::cbor::decode(json::byte_stream const& stream) -> json
@@ -427,6 +751,100 @@ auto ::cxx::cbor::decode(json::byte_stream const& stream) -> json
 auto ::cxx::cbor::decode(cxx::by_ref<json::byte_view> bytes) -> json
 {
   cxx::json json;
-  bytes.get() = parse(bytes.c_ref(), emplace_to<cxx::json>(cxx::by_ref(json)));
+  bytes.get() = parse(bytes.c_ref(), emplace_to<cxx::json>(cxx::by_ref(json), {}));
   return json;
 }
+
+auto ::cxx::cbor::decode(std::vector<json::byte_view> const& segments) -> json
+{
+  ::cxx::codec::segments in(segments.data(), segments.data() + std::size(segments));
+  cxx::json json;
+  ::gather(cxx::by_ref(in), emplace_to<cxx::json>(cxx::by_ref(json), {}), max_nesting);
+  return json;
+}
+
+auto ::cxx::cbor::decode(std::vector<iovec> const& segments) -> json
+{
+  std::vector<json::byte_view> views;
+  views.reserve(std::size(segments));
+  for (auto const& x : segments)
+    views.emplace_back(static_cast<cxx::byte const*>(x.iov_base), x.iov_len);
+  return decode(views);
+}
+
+auto ::cxx::cbor::decode(json::byte_stream const& stream, std::pmr::memory_resource* resource)
+    -> pmr::json
+{
+  cxx::json::byte_view data(stream.data(), std::size(stream));
+  return decode(cxx::by_ref(data), resource);
+}
+
+auto ::cxx::cbor::decode(cxx::by_ref<json::byte_view> bytes, std::pmr::memory_resource* resource)
+    -> pmr::json
+{
+  cxx::pmr::json json;
+  bytes.get() = parse(bytes.c_ref(), emplace_to<cxx::pmr::json>(cxx::by_ref(json), resource));
+  return json;
+}
+
+auto ::cxx::cbor::decode(json::byte_stream const& stream, cxx::arena& arena) -> pmr::json&
+{
+  cxx::json::byte_view data(stream.data(), std::size(stream));
+  return decode(cxx::by_ref(data), arena);
+}
+
+auto ::cxx::cbor::decode(cxx::by_ref<json::byte_view> bytes, cxx::arena& arena) -> pmr::json&
+{
+  return arena.construct<cxx::pmr::json>(decode(cxx::by_ref(bytes), &arena));
+}
+
+auto ::cxx::cbor::decode_tape(json::byte_stream const& stream) -> tape
+{
+  cxx::json::byte_view data(stream.data(), std::size(stream));
+  return decode_tape(cxx::by_ref(data));
+}
+
+auto ::cxx::cbor::decode_tape(cxx::by_ref<json::byte_view> bytes) -> tape
+{
+  cxx::tape doc;
+  cxx::tape::builder out{cxx::by_ref(doc)};
+  out.reserve(std::size(bytes.c_ref()));
+  bytes.get() =
+      ::parse(bytes.c_ref(), emplace_to<cxx::detail::tape_json>(cxx::by_ref(doc), &out));
+  return doc;
+}
+
+auto ::cxx::cbor::decode_view(json::byte_stream const& stream) -> json_view
+{
+  cxx::json::byte_view data(stream.data(), std::size(stream));
+  return decode_view(cxx::by_ref(data));
+}
+
+auto ::cxx::cbor::decode_view(cxx::by_ref<json::byte_view> bytes) -> json_view
+{
+  cxx::json_view json;
+  bytes.get() = parse(bytes.c_ref(), emplace_to<cxx::json_view>(cxx::by_ref(json), {}));
+  return json;
+}
+
+auto ::cxx::cbor::decode_lazy(json::byte_stream const& stream) -> lazy
+{
+  return lazy(cxx::json::byte_view(stream.data(), std::size(stream)), lazy_format);
+}
+
+auto ::cxx::cbor::decode_lazy(cxx::by_ref<json::byte_view> bytes) -> lazy
+{
+  return lazy(slice(cxx::by_ref(bytes)), lazy_format);
+}
+
+void ::cxx::cbor::decode_into(json::byte_stream const& stream, cxx::by_ref<json> target)
+{
+  cxx::json::byte_view data(stream.data(), std::size(stream));
+  decode_into(cxx::by_ref(data), cxx::by_ref(target));
+}
+
+void ::cxx::cbor::decode_into(cxx::by_ref<json::byte_view> bytes, cxx::by_ref<json> target)
+{
+  bytes.get() =
+      ::parse(bytes.c_ref(), emplace_to<cxx::detail::reuse_json>(cxx::by_ref(target), nullptr));
+}
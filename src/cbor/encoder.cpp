@@ -6,123 +6,263 @@
 
 namespace detail
 {
-  void encode(cxx::json const&, cxx::json::byte_stream&) noexcept;
+  template <template <typename> typename Allocator>
+  void encode(cxx::basic_json<Allocator> const&, ::cxx::codec::writer&) noexcept;
 
-  [[gnu::flatten]] cxx::byte& encode_positive_integer(std::uint64_t x,
-                                                      cxx::json::byte_stream& stream) noexcept
+  template <template <typename> typename Allocator>
+  std::size_t size_of(cxx::basic_json<Allocator> const&) noexcept;
+
+  constexpr std::size_t head(std::uint64_t x) noexcept
+  {
+    if (x <= ::cxx::detail::cbor::initial_byte::value::max_insitu) return 1;
+    return 1 + ::cxx::codec::space(x);
+  }
+
+  constexpr std::size_t size_of(std::int64_t x) noexcept
+  {
+    return head(static_cast<std::uint64_t>(x < 0 ? -(x + 1) : x));
+  }
+
+  template <typename T, typename Allocator>
+  std::size_t size_of(std::vector<T, Allocator> const& x) noexcept
+  {
+    auto ret = head(std::size(x));
+    if constexpr (std::is_same_v<T, cxx::byte>)
+      ret += std::size(x);
+    else
+      for (auto const& item : x) ret += ::detail::size_of(item);
+    return ret;
+  }
+
+  template <typename Allocator>
+  std::size_t size_of(std::basic_string<char, std::char_traits<char>, Allocator> const& x) noexcept
+  {
+    return head(std::size(x)) + std::size(x);
+  }
+
+  template <typename Key, typename T, typename Compare, typename Allocator>
+  std::size_t size_of(cxx::flat_map<Key, T, Compare, Allocator> const& x) noexcept
+  {
+    auto ret = head(std::size(x));
+    for (auto const& [key, value] : x) ret += ::detail::size_of(key) + ::detail::size_of(value);
+    return ret;
+  }
+
+  constexpr std::size_t size_of(double) noexcept { return sizeof(double) + 1; }
+  constexpr std::size_t size_of(bool) noexcept { return 1; }
+  constexpr std::size_t size_of(cxx::json::null_t) noexcept { return 1; }
+
+  template <template <typename> typename Allocator>
+  [[gnu::noinline]] std::size_t size_of(cxx::basic_json<Allocator> const& json) noexcept
   {
-    auto& init = stream.emplace_back(cxx::byte(x));
-    if (x <= ::cxx::detail::cbor::initial_byte::value::max_insitu) return init;
+    return cxx::visit([](auto const& x) { return ::detail::size_of(x); }, json);
+  }
+
+  [[gnu::always_inline]] inline cxx::byte* write_head(cxx::byte* it,
+                                                      ::cxx::codec::numbyte const major,
+                                                      std::uint64_t x) noexcept
+  {
+    auto const type = static_cast<::cxx::codec::numbyte>(major << 5);
+    if (x <= ::cxx::detail::cbor::initial_byte::value::max_insitu)
+    {
+      *it = cxx::byte(type | x);
+      return it + 1;
+    }
     auto const code = ::cxx::codec::code(x);
-    init = cxx::byte(::cxx::detail::cbor::initial_byte::value::max_insitu + code + 1);
-    auto const space = ::cxx::codec::space(x);
-    auto it = stream.insert(std::end(stream), space, {});
+    *it++ = cxx::byte(type | (::cxx::detail::cbor::initial_byte::value::max_insitu + code + 1));
     switch (code)
     {
       case 0:
         *it = cxx::byte(0xff & x);
-        break;
+        return it + sizeof(std::uint8_t);
       case 1:
-        ::cxx::codec::write_to(::cxx::codec::hton(static_cast<std::uint16_t>(0xffff & x)),
-                               std::addressof(*it));
-        break;
+        ::cxx::codec::write_to(::cxx::codec::hton(static_cast<std::uint16_t>(0xffff & x)), it);
+        return it + sizeof(std::uint16_t);
       case 2:
         ::cxx::codec::write_to(::cxx::codec::hton(static_cast<std::uint32_t>(0xffffffff & x)),
-                               std::addressof(*it));
-        break;
-      case 3:
-        ::cxx::codec::write_to(::cxx::codec::hton(x), std::addressof(*it));
-        break;
+                               it);
+        return it + sizeof(std::uint32_t);
+      default:
+        ::cxx::codec::write_to(::cxx::codec::hton(x), it);
+        return it + sizeof(std::uint64_t);
     }
-    return *(--it);
   }
 
-  [[gnu::flatten]] void encode_negative_integer(std::int64_t x,
-                                                cxx::json::byte_stream& stream) noexcept
+  [[gnu::flatten]] void encode(std::int64_t x, ::cxx::codec::writer& out) noexcept
   {
-    ::cxx::detail::cbor::initial(
-        encode_positive_integer(static_cast<std::uint64_t>(-(x + 1)), stream))
-        ->major = ::cxx::detail::cbor::initial_byte::type::negative;
+    auto* it = out.reserve(size_of(x));
+    if (x < 0)
+      out.commit(write_head(it, ::cxx::detail::cbor::initial_byte::type::negative,
+                            static_cast<std::uint64_t>(-(x + 1))));
+    else
+      out.commit(write_head(it, ::cxx::detail::cbor::initial_byte::type::positive,
+                            static_cast<std::uint64_t>(x)));
   }
 
-  [[gnu::flatten]] void encode(std::int64_t x, cxx::json::byte_stream& stream) noexcept
+  [[gnu::flatten]] void encode(cxx::byte const* first, std::size_t size,
+                               ::cxx::codec::numbyte const major,
+                               ::cxx::codec::writer& out) noexcept
   {
-    ::cxx::codec::assure(cxx::by_ref(stream), sizeof(std::int64_t) + 1);
-    if (x < 0) return encode_negative_integer(x, stream);
-    encode_positive_integer(static_cast<std::uint64_t>(x), stream);
+    out.commit(write_head(out.reserve(head(size)), major, size));
+    out.append(first, size);
   }
 
-  [[gnu::flatten]] void encode(cxx::json::byte_stream const& x,
-                               cxx::json::byte_stream& stream) noexcept
+  template <typename Allocator>
+  [[gnu::flatten]] void encode(std::vector<cxx::byte, Allocator> const& x,
+                               ::cxx::codec::writer& out) noexcept
   {
-    ::cxx::codec::assure(cxx::by_ref(stream), std::size(x) + sizeof(std::uint64_t) + 1);
-    ::cxx::detail::cbor::initial(encode_positive_integer(std::size(x), stream))->major =
-        ::cxx::detail::cbor::initial_byte::type::bytes;
-    stream.insert(std::end(stream), std::begin(x), std::end(x));
+    encode(x.data(), std::size(x), ::cxx::detail::cbor::initial_byte::type::bytes, out);
   }
 
-  [[gnu::flatten]] void encode(std::string const& x, cxx::json::byte_stream& stream) noexcept
+  template <typename Allocator>
+  [[gnu::flatten]] void encode(std::basic_string<char, std::char_traits<char>, Allocator> const& x,
+                               ::cxx::codec::writer& out) noexcept
   {
-    ::cxx::codec::assure(cxx::by_ref(stream), std::size(x) + sizeof(std::uint64_t) + 1);
-    ::cxx::detail::cbor::initial(encode_positive_integer(std::size(x), stream))->major =
-        ::cxx::detail::cbor::initial_byte::type::unicode;
-    auto first = reinterpret_cast<cxx::byte const*>(x.data());
-    stream.insert(std::end(stream), first, first + std::size(x));
+    encode(reinterpret_cast<cxx::byte const*>(x.data()), std::size(x),
+           ::cxx::detail::cbor::initial_byte::type::unicode, out);
   }
 
-  [[gnu::flatten]] void encode(cxx::json::array const& x, cxx::json::byte_stream& stream) noexcept
+  template <template <typename> typename Allocator>
+  [[gnu::flatten]] void encode(std::vector<cxx::basic_json<Allocator>,
+                                           Allocator<cxx::basic_json<Allocator>>> const& x,
+                               ::cxx::codec::writer& out) noexcept
   {
-    ::cxx::codec::assure(cxx::by_ref(stream),
-                         sizeof(std::uint64_t) + 1 + std::size(x) * sizeof(cxx::json));
-    ::cxx::detail::cbor::initial(encode_positive_integer(std::size(x), stream))->major =
-        ::cxx::detail::cbor::initial_byte::type::array;
-    for (auto const& item : x) ::detail::encode(item, stream);
+    out.commit(write_head(out.reserve(head(std::size(x))),
+                          ::cxx::detail::cbor::initial_byte::type::array, std::size(x)));
+    for (auto const& item : x) ::detail::encode(item, out);
   }
 
-  [[gnu::flatten]] void encode(cxx::json::dictionary const& x,
-                               cxx::json::byte_stream& stream) noexcept
+  template <typename Key, typename T, typename Compare, typename Allocator>
+  [[gnu::flatten]] void encode(cxx::flat_map<Key, T, Compare, Allocator> const& x,
+                               ::cxx::codec::writer& out) noexcept
   {
-    ::cxx::codec::assure(cxx::by_ref(stream),
-                         sizeof(std::uint64_t) + 1 + 2 * std::size(x) * sizeof(cxx::json));
-    ::cxx::detail::cbor::initial(encode_positive_integer(std::size(x), stream))->major =
-        ::cxx::detail::cbor::initial_byte::type::dictionary;
+    out.commit(write_head(out.reserve(head(std::size(x))),
+                          ::cxx::detail::cbor::initial_byte::type::dictionary, std::size(x)));
     for (auto const& [key, value] : x)
     {
-      ::detail::encode(key, stream);
-      ::detail::encode(value, stream);
+      ::detail::encode(key, out);
+      ::detail::encode(value, out);
     }
   }
 
-  [[gnu::flatten]] void encode(bool b, cxx::json::byte_stream& stream) noexcept
+  [[gnu::flatten]] void encode_simple(::cxx::codec::numbyte const x,
+                                      ::cxx::codec::writer& out) noexcept
+  {
+    auto* it = out.reserve(1);
+    *it = cxx::byte(x);
+    out.commit(it + 1);
+  }
+
+  [[gnu::flatten]] void encode(bool b, ::cxx::codec::writer& out) noexcept
   {
-    stream.emplace_back(cxx::byte(b ? ::cxx::detail::cbor::initial_byte::value::True
-                                    : ::cxx::detail::cbor::initial_byte::value::False));
+    encode_simple(b ? ::cxx::detail::cbor::initial_byte::value::True
+                    : ::cxx::detail::cbor::initial_byte::value::False,
+                  out);
   }
 
-  [[gnu::flatten]] void encode(cxx::json::null_t, cxx::json::byte_stream& stream) noexcept
+  [[gnu::flatten]] void encode(cxx::json::null_t, ::cxx::codec::writer& out) noexcept
   {
-    stream.emplace_back(cxx::byte(::cxx::detail::cbor::initial_byte::value::Null));
+    encode_simple(::cxx::detail::cbor::initial_byte::value::Null, out);
   }
 
-  [[gnu::flatten]] void encode(double d, cxx::json::byte_stream& stream) noexcept
+  [[gnu::flatten]] void encode(double d, ::cxx::codec::writer& out) noexcept
   {
-    ::cxx::codec::assure(cxx::by_ref(stream), sizeof(double) + 1);
-    d = ::cxx::codec::hton(d);
-    auto const* first = static_cast<cxx::byte const*>(static_cast<void const*>(&d));
-    stream.emplace_back(cxx::byte(::cxx::detail::cbor::initial_byte::value::ieee_754_double));
-    stream.insert(std::end(stream), first, first + sizeof(double));
+    auto* it = out.reserve(sizeof(double) + 1);
+    *it = cxx::byte(::cxx::detail::cbor::initial_byte::value::ieee_754_double);
+    ::cxx::codec::write_to(::cxx::codec::hton(d), it + 1);
+    out.commit(it + 1 + sizeof(double));
   }
 
-  [[gnu::noinline, gnu::flatten]] void encode(cxx::json const& json,
-                                              cxx::json::byte_stream& stream) noexcept
+  template <template <typename> typename Allocator>
+  [[gnu::noinline, gnu::flatten]] void encode(cxx::basic_json<Allocator> const& json,
+                                              ::cxx::codec::writer& out) noexcept
   {
-    cxx::visit([&stream](auto const& x) { ::detail::encode(x, stream); }, json);
+    cxx::visit([&out](auto const& x) { ::detail::encode(x, out); }, json);
   }
 } // namespace detail
 
 auto ::cxx::cbor::encode(json const& j) noexcept -> json::byte_stream
 {
   json::byte_stream stream;
-  ::detail::encode(j, stream);
+  encode_into(j, cxx::by_ref(stream));
   return stream;
 }
+
+template <template <typename> typename Allocator>
+auto ::cxx::cbor::encode(basic_json<Allocator> const& j) noexcept -> json::byte_stream
+{
+  json::byte_stream stream;
+  encode_into(j, cxx::by_ref(stream));
+  return stream;
+}
+
+void ::cxx::cbor::encode_into(json const& j, cxx::by_ref<json::byte_stream> out) noexcept
+{
+  ::cxx::codec::writer writer{cxx::by_ref(out)};
+  ::detail::encode(j, writer);
+  writer.flush();
+}
+
+template <template <typename> typename Allocator>
+void ::cxx::cbor::encode_into(basic_json<Allocator> const& j,
+                              cxx::by_ref<json::byte_stream> out) noexcept
+{
+  ::cxx::codec::writer writer{cxx::by_ref(out)};
+  ::detail::encode(j, writer);
+  writer.flush();
+}
+
+void ::cxx::cbor::encode_into(json const& j, cxx::by_ref<byte_chain> out) noexcept
+{
+  ::cxx::codec::writer writer{cxx::by_ref(out)};
+  ::detail::encode(j, writer);
+  writer.flush();
+}
+
+template <template <typename> typename Allocator>
+void ::cxx::cbor::encode_into(basic_json<Allocator> const& j,
+                              cxx::by_ref<byte_chain> out) noexcept
+{
+  ::cxx::codec::writer writer{cxx::by_ref(out)};
+  ::detail::encode(j, writer);
+  writer.flush();
+}
+
+auto ::cxx::cbor::encoded_size(json const& j) noexcept -> std::size_t
+{
+  return ::detail::size_of(j);
+}
+
+template <template <typename> typename Allocator>
+auto ::cxx::cbor::encoded_size(basic_json<Allocator> const& j) noexcept -> std::size_t
+{
+  return ::detail::size_of(j);
+}
+
+auto ::cxx::cbor::encode_to(json const& j, cxx::byte* out, std::size_t size) noexcept
+    -> std::optional<std::size_t>
+{
+  auto const needed = encoded_size(j);
+  if (needed > size) return std::nullopt;
+  ::cxx::codec::writer writer(out, size);
+  ::detail::encode(j, writer);
+  return needed;
+}
+
+template <template <typename> typename Allocator>
+auto ::cxx::cbor::encode_to(basic_json<Allocator> const& j, cxx::byte* out,
+                            std::size_t size) noexcept -> std::optional<std::size_t>
+{
+  auto const needed = encoded_size(j);
+  if (needed > size) return std::nullopt;
+  ::cxx::codec::writer writer(out, size);
+  ::detail::encode(j, writer);
+  return needed;
+}
+
+template auto ::cxx::cbor::encode(pmr::json const&) noexcept -> json::byte_stream;
+template void ::cxx::cbor::encode_into(pmr::json const&, cxx::by_ref<json::byte_stream>) noexcept;
+template void ::cxx::cbor::encode_into(pmr::json const&, cxx::by_ref<byte_chain>) noexcept;
+template auto ::cxx::cbor::encoded_size(pmr::json const&) noexcept -> std::size_t;
+template auto ::cxx::cbor::encode_to(pmr::json const&, cxx::byte*, std::size_t) noexcept
+    -> std::optional<std::size_t>;
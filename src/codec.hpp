@@ -1,6 +1,10 @@
 #pragma once
 #include "inc/cxx/json.hpp"
 #include "inc/cxx/by_ref.hpp"
+#include "inc/cxx/byte_chain.hpp"
+#include <algorithm>
+#include <limits>
+#include <tuple>
 #include <arpa/inet.h>
 
 namespace cxx
@@ -31,26 +35,176 @@ namespace cxx
     inline static constexpr auto const space = [](std::uint64_t x) { return 1u << code(x); };
 
     /**
-     *
+     * output cursor of the encoders: reserve makes room for a header and returns where it goes,
+     * commit takes the position past the last byte written and append copies a payload. Output
+     * to a byte_stream is staged in a small buffer and appended to the stream in bulk by flush,
+     * a fixed region is written directly and must be known to be large enough. A byte_chain is
+     * written segment by segment, payloads of its min_reference size or more are referenced.
      */
-    inline static constexpr auto const available = [](cxx::json::byte_stream const& stream) {
-      return stream.capacity() - std::size(stream);
-    };
+    class writer
+    {
+    public:
+      explicit writer(cxx::by_ref<cxx::json::byte_stream> out) noexcept
+          : stream(&out.get()), pos(std::begin(staged)), limit(std::end(staged))
+      {
+      }
 
-    /**
-     *
-     */
-    inline static constexpr auto const append = [](cxx::by_ref<cxx::json::byte_stream> stream,
-                                                   cxx::json::byte_stream::size_type const size) {
-      return stream->reserve(stream->capacity() + size);
+      explicit writer(cxx::by_ref<cxx::byte_chain> out)
+          : chain(&out.get()), borrow(out->min_reference)
+      {
+        std::tie(pos, limit) = chain->open(0);
+      }
+
+      writer(cxx::byte* data, std::size_t size) noexcept : pos(data), limit(data + size) {}
+      writer(writer const&) = delete;
+      writer& operator=(writer const&) = delete;
+
+      cxx::byte* reserve(std::size_t n)
+      {
+        if (static_cast<std::size_t>(limit - pos) < n) refill(n);
+        return pos;
+      }
+
+      void commit(cxx::byte* end) noexcept { pos = end; }
+
+      void append(cxx::byte const* first, std::size_t n)
+      {
+        if (static_cast<std::size_t>(limit - pos) < n || n >= borrow) return spill(first, n);
+        pos = std::copy(first, first + n, pos);
+      }
+
+      /**
+       * moves the staged bytes to the stream or the chain, does nothing for a fixed region
+       */
+      void flush()
+      {
+        if (stream)
+          drain();
+        else if (chain)
+          chain->close(pos);
+      }
+
+    private:
+      [[gnu::noinline]] void drain()
+      {
+        stream->insert(std::end(*stream), std::begin(staged), pos);
+        pos = std::begin(staged);
+      }
+
+      [[gnu::noinline]] void refill(std::size_t n)
+      {
+        flush();
+        if (chain) std::tie(pos, limit) = chain->open(n);
+      }
+
+      [[gnu::noinline]] void spill(cxx::byte const* first, std::size_t n)
+      {
+        if (stream)
+        {
+          flush();
+          stream->insert(std::end(*stream), first, first + n);
+          return;
+        }
+        if (n >= borrow)
+        {
+          chain->close(pos);
+          return chain->reference(first, n);
+        }
+        for (;;)
+        {
+          auto const part = std::min(n, static_cast<std::size_t>(limit - pos));
+          pos = std::copy(first, first + part, pos);
+          if ((n -= part) == 0) return;
+          first += part;
+          refill(1);
+        }
+      }
+
+      cxx::json::byte_stream* stream = nullptr;
+      cxx::byte_chain* chain = nullptr;
+      std::size_t borrow = std::numeric_limits<std::size_t>::max();
+      cxx::byte staged[512];
+      cxx::byte* pos;
+      cxx::byte* limit;
     };
 
     /**
-     *
+     * input of the decoders spread over several buffers. peek returns the n bytes at an offset
+     * from the front as one view, it points into a buffer unless they straddle a boundary, in
+     * which case they are copied together and the view is only valid until the next peek.
      */
-    inline static constexpr auto const assure = [](cxx::by_ref<cxx::json::byte_stream> stream,
-                                                   cxx::json::byte_stream::size_type const needed) {
-      if (available(stream.c_ref()) < needed) append(cxx::by_ref(stream), needed);
+    class segments
+    {
+    public:
+      segments(cxx::json::byte_view const* first, cxx::json::byte_view const* end) noexcept
+          : next(first), last(end)
+      {
+        for (auto it = first; it != end; ++it) left += std::size(*it);
+        skip(0);
+      }
+
+      segments(segments const&) = delete;
+      segments& operator=(segments const&) = delete;
+
+      /**
+       * bytes left and how many of them can be peeked without copying
+       */
+      std::size_t size() const noexcept { return left; }
+      std::size_t contiguous() const noexcept { return std::size(front); }
+
+      /**
+       * empty if fewer than offset + n bytes are left
+       */
+      cxx::json::byte_view peek(std::size_t offset, std::size_t n)
+      {
+        if (offset + n <= std::size(front)) return front.substr(offset, n);
+        if (offset + n > left) return {};
+        return stitch(offset, n);
+      }
+
+      /**
+       * n must not exceed size
+       */
+      void skip(std::size_t n) noexcept
+      {
+        left -= n;
+        while (n > std::size(front))
+        {
+          n -= std::size(front);
+          front = *next++;
+        }
+        front.remove_prefix(n);
+        while (std::empty(front) && next != last) front = *next++;
+      }
+
+    private:
+      [[gnu::noinline]] cxx::json::byte_view stitch(std::size_t offset, std::size_t n)
+      {
+        auto view = front;
+        auto const* it = next;
+        while (offset >= std::size(view))
+        {
+          offset -= std::size(view);
+          view = *it++;
+        }
+        view.remove_prefix(offset);
+        if (n <= std::size(view)) return view.substr(0, n);
+        stitched.clear();
+        while (std::size(stitched) + std::size(view) < n)
+        {
+          stitched.insert(std::end(stitched), std::begin(view), std::end(view));
+          view = *it++;
+        }
+        stitched.insert(std::end(stitched), std::begin(view),
+                        std::begin(view) + static_cast<std::ptrdiff_t>(n - std::size(stitched)));
+        return {stitched.data(), n};
+      }
+
+      cxx::json::byte_view front;
+      cxx::json::byte_view const* next;
+      cxx::json::byte_view const* last;
+      std::size_t left = 0;
+      cxx::json::byte_stream stitched;
     };
 
     /**
@@ -211,5 +365,42 @@ namespace cxx
         return ntoh(x);
       }
     };
+
+    /**
+     * decoder callback, remembers the node type and the allocator of the tree being built
+     */
+    template <typename Json, typename F>
+    struct sink : F {
+      using json_type = Json;
+      typename Json::allocator alloc;
+    };
+
+    /**
+     * node types whose strings and byte streams point into the decoded buffer
+     */
+    template <typename Json>
+    static constexpr bool const borrows = std::is_same_v<typename Json::string, std::string_view>;
+
+    /**
+     * copies decoded text and bytes into containers allocated like the rest of the tree,
+     * views are passed through when Json borrows them
+     */
+    template <typename Json, typename T>
+    static decltype(auto) own(T&& x, typename Json::allocator const& alloc)
+    {
+      using string = typename Json::string;
+      if constexpr (std::is_same_v<std::decay_t<T>, string> ||
+                    std::is_same_v<std::decay_t<T>, typename Json::byte_stream>)
+        return std::forward<T>(x);
+      else if constexpr (std::is_convertible_v<T, std::string_view>)
+      {
+        std::string_view const text = x;
+        return string(text.data(), std::size(text), alloc);
+      }
+      else if constexpr (std::is_same_v<std::decay_t<T>, cxx::json::byte_view>)
+        return typename Json::byte_stream(x.data(), x.data() + std::size(x), alloc);
+      else
+        return std::forward<T>(x);
+    }
   };
 } // namespace cxx
@@ -0,0 +1,170 @@
+#include "inc/cxx/compact.hpp"
+#include <cstring>
+
+namespace
+{
+  template <typename T, typename = void>
+  struct has_size : std::false_type {
+  };
+
+  template <typename T>
+  struct has_size<
+      T,
+      std::void_t<decltype(std::declval<std::size_t&>() = (std::declval<T const&>().size()))>>
+      : std::true_type {
+  };
+
+  auto const from_json = cxx::overload{
+      [](cxx::json::dictionary const& x) -> cxx::compact {
+        cxx::compact::dictionary ret;
+        for (auto const& [key, value] : x) ret.emplace_hint(std::end(ret), key, value);
+        return ret;
+      },
+      [](cxx::json::array const& x) -> cxx::compact {
+        return cxx::compact::array(std::begin(x), std::end(x));
+      },
+      [](auto const& x) -> cxx::compact { return x; }};
+} // namespace
+
+[[gnu::flatten]] ::cxx::compact::compact(std::string_view x)
+{
+  if (std::size(x) <= small_capacity)
+  {
+    std::memcpy(u.text.data, x.data(), std::size(x));
+    u.text.meta = meta(tag::small, std::size(x));
+  }
+  else
+  {
+    u.str = new std::string(x);
+    u.text.meta = meta(tag::string);
+  }
+}
+
+[[gnu::flatten]] ::cxx::compact::compact(dictionary x)
+{
+  u.dict = new dictionary(std::move(x));
+  u.text.meta = meta(tag::dictionary);
+}
+
+[[gnu::flatten]] ::cxx::compact::compact(array x)
+{
+  u.items = new array(std::move(x));
+  u.text.meta = meta(tag::array);
+}
+
+[[gnu::flatten]] ::cxx::compact::compact(byte_stream x)
+{
+  u.bytes = new byte_stream(std::move(x));
+  u.text.meta = meta(tag::bytes);
+}
+
+[[gnu::flatten]] ::cxx::compact::compact(json const& x) : compact(cxx::visit(from_json, x)) {}
+
+[[gnu::flatten]] ::cxx::compact::compact(compact const& other) : u(other.u)
+{
+  switch (other.type())
+  {
+    case tag::dictionary:
+      u.dict = new dictionary(*other.u.dict);
+      break;
+    case tag::array:
+      u.items = new array(*other.u.items);
+      break;
+    case tag::string:
+      u.str = new std::string(*other.u.str);
+      break;
+    case tag::bytes:
+      u.bytes = new byte_stream(*other.u.bytes);
+      break;
+    default:
+      break;
+  }
+}
+
+[[gnu::flatten]] auto ::cxx::compact::operator=(compact const& other) -> compact&
+{
+  if (this != &other) *this = compact(other);
+  return *this;
+}
+
+[[gnu::flatten]] auto ::cxx::compact::operator=(compact&& other) noexcept -> compact&
+{
+  if (this != &other)
+  {
+    release();
+    u = other.u;
+    other.u.text.meta = meta(tag::null);
+  }
+  return *this;
+}
+
+void ::cxx::compact::release() noexcept
+{
+  switch (type())
+  {
+    case tag::dictionary:
+      delete u.dict;
+      break;
+    case tag::array:
+      delete u.items;
+      break;
+    case tag::string:
+      delete u.str;
+      break;
+    case tag::bytes:
+      delete u.bytes;
+      break;
+    default:
+      break;
+  }
+}
+
+[[gnu::flatten]] auto ::cxx::compact::operator[](std::string const& k) -> compact&
+{
+  return get<dictionary>()[k];
+}
+
+[[gnu::flatten]] auto ::cxx::compact::operator[](std::string const& k) const -> compact const&
+{
+  return get<dictionary>().at(k);
+}
+
+[[gnu::flatten]] auto ::cxx::compact::operator[](std::size_t k) -> compact&
+{
+  return get<array>().at(k);
+}
+
+[[gnu::flatten]] auto ::cxx::compact::operator[](std::size_t k) const -> compact const&
+{
+  return get<array>().at(k);
+}
+
+[[gnu::flatten]] auto ::cxx::compact::size() const noexcept -> std::size_t
+{
+  auto const func = cxx::overload{[](cxx::compact::null_t) -> std::size_t { return 0; },
+                                  [](auto const& x) -> std::size_t {
+                                    if constexpr (has_size<decltype(x)>::value)
+                                      return std::size(x);
+                                    else
+                                      return 1;
+                                  }};
+  return visit(func);
+}
+
+[[gnu::flatten]] bool ::cxx::compact::empty() const noexcept
+{
+  return size() == 0;
+}
+
+[[gnu::flatten]] bool ::cxx::operator==(compact const& lhs, compact const& rhs) noexcept
+{
+  return lhs.visit([&rhs](auto const& x) -> bool {
+    using type = std::decay_t<decltype(x)>;
+    return rhs.holds_alternative<type>() && rhs.get<type>() == x;
+  });
+}
+
+[[gnu::flatten]] bool ::cxx::operator!=(compact const& lhs, compact const& rhs) noexcept
+{
+  return !(lhs == rhs);
+}
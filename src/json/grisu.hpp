@@ -0,0 +1,398 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+/*
+ * Shortest round-trip formatting of doubles, Grisu2 of Florian Loitsch,
+ * "Printing Floating-Point Numbers Quickly and Accurately with Integers" (PLDI 2010).
+ * Produced digits always parse back to the very same double and are the
+ * shortest such representation for all but a tiny fraction of inputs.
+ */
+namespace cxx::detail::grisu
+{
+  struct diyfp {
+    std::uint64_t f = 0;
+    int e = 0;
+
+    static constexpr int const precision = 64;
+
+    constexpr diyfp(std::uint64_t x, int y) noexcept : f(x), e(y) {}
+
+    static constexpr diyfp sub(diyfp x, diyfp y) noexcept { return {x.f - y.f, x.e}; }
+
+    /*
+     * upper 64 bits of the 128-bit product, rounded half up
+     */
+    static constexpr diyfp mul(diyfp x, diyfp y) noexcept
+    {
+      std::uint64_t const u_lo = x.f & 0xffffffffu;
+      std::uint64_t const u_hi = x.f >> 32u;
+      std::uint64_t const v_lo = y.f & 0xffffffffu;
+      std::uint64_t const v_hi = y.f >> 32u;
+
+      std::uint64_t const p0 = u_lo * v_lo;
+      std::uint64_t const p1 = u_lo * v_hi;
+      std::uint64_t const p2 = u_hi * v_lo;
+      std::uint64_t const p3 = u_hi * v_hi;
+
+      std::uint64_t q = (p0 >> 32u) + (p1 & 0xffffffffu) + (p2 & 0xffffffffu);
+      q += std::uint64_t{1} << 31u;
+      std::uint64_t const h = p3 + (p2 >> 32u) + (p1 >> 32u) + (q >> 32u);
+      return {h, x.e + y.e + 64};
+    }
+
+    static constexpr diyfp normalize(diyfp x) noexcept
+    {
+      while ((x.f >> 63u) == 0)
+      {
+        x.f <<= 1u;
+        x.e--;
+      }
+      return x;
+    }
+
+    static constexpr diyfp normalize_to(diyfp x, int e) noexcept
+    {
+      return {x.f << (x.e - e), e};
+    }
+  };
+
+  /*
+   * normalized value together with its normalized neighbourhood boundaries
+   */
+  struct boundaries {
+    diyfp w;
+    diyfp minus;
+    diyfp plus;
+  };
+
+  inline boundaries compute_boundaries(double value) noexcept
+  {
+    static_assert(std::numeric_limits<double>::is_iec559);
+    constexpr int const digits = std::numeric_limits<double>::digits; // 53
+    constexpr int const bias = std::numeric_limits<double>::max_exponent - 1 + (digits - 1);
+    constexpr int const min_exp = 1 - bias;
+    constexpr std::uint64_t const hidden_bit = std::uint64_t{1} << (digits - 1);
+
+    std::uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    auto const E = bits >> (digits - 1);
+    auto const F = bits & (hidden_bit - 1);
+
+    auto const v = (E == 0) ? diyfp(F, min_exp)
+                            : diyfp(F + hidden_bit, static_cast<int>(E) - bias);
+    bool const lower_boundary_is_closer = (F == 0 && E > 1);
+    auto const m_plus = diyfp(2 * v.f + 1, v.e - 1);
+    auto const m_minus = lower_boundary_is_closer ? diyfp(4 * v.f - 1, v.e - 2)
+                                                  : diyfp(2 * v.f - 1, v.e - 1);
+    auto const w_plus = diyfp::normalize(m_plus);
+    auto const w_minus = diyfp::normalize_to(m_minus, w_plus.e);
+    return {diyfp::normalize(v), w_minus, w_plus};
+  }
+
+  struct cached_power {
+    std::uint64_t f;
+    int e;
+    int k;
+  };
+
+  /*
+   * normalized 10^k for k = -300, -292, ..., 324, rounded to nearest
+   */
+  constexpr int const min_decimal_exponent = -300;
+  constexpr int const decimal_exponent_step = 8;
+  constexpr std::array<cached_power, 79> const cached_powers = {{
+      {0xAB70FE17C79AC6CA, -1060, -300},
+      {0xFF77B1FCBEBCDC4F, -1034, -292},
+      {0xBE5691EF416BD60C, -1007, -284},
+      {0x8DD01FAD907FFC3C, -980, -276},
+      {0xD3515C2831559A83, -954, -268},
+      {0x9D71AC8FADA6C9B5, -927, -260},
+      {0xEA9C227723EE8BCB, -901, -252},
+      {0xAECC49914078536D, -874, -244},
+      {0x823C12795DB6CE57, -847, -236},
+      {0xC21094364DFB5637, -821, -228},
+      {0x9096EA6F3848984F, -794, -220},
+      {0xD77485CB25823AC7, -768, -212},
+      {0xA086CFCD97BF97F4, -741, -204},
+      {0xEF340A98172AACE5, -715, -196},
+      {0xB23867FB2A35B28E, -688, -188},
+      {0x84C8D4DFD2C63F3B, -661, -180},
+      {0xC5DD44271AD3CDBA, -635, -172},
+      {0x936B9FCEBB25C996, -608, -164},
+      {0xDBAC6C247D62A584, -582, -156},
+      {0xA3AB66580D5FDAF6, -555, -148},
+      {0xF3E2F893DEC3F126, -529, -140},
+      {0xB5B5ADA8AAFF80B8, -502, -132},
+      {0x87625F056C7C4A8B, -475, -124},
+      {0xC9BCFF6034C13053, -449, -116},
+      {0x964E858C91BA2655, -422, -108},
+      {0xDFF9772470297EBD, -396, -100},
+      {0xA6DFBD9FB8E5B88F, -369, -92},
+      {0xF8A95FCF88747D94, -343, -84},
+      {0xB94470938FA89BCF, -316, -76},
+      {0x8A08F0F8BF0F156B, -289, -68},
+      {0xCDB02555653131B6, -263, -60},
+      {0x993FE2C6D07B7FAC, -236, -52},
+      {0xE45C10C42A2B3B06, -210, -44},
+      {0xAA242499697392D3, -183, -36},
+      {0xFD87B5F28300CA0E, -157, -28},
+      {0xBCE5086492111AEB, -130, -20},
+      {0x8CBCCC096F5088CC, -103, -12},
+      {0xD1B71758E219652C, -77, -4},
+      {0x9C40000000000000, -50, 4},
+      {0xE8D4A51000000000, -24, 12},
+      {0xAD78EBC5AC620000, 3, 20},
+      {0x813F3978F8940984, 30, 28},
+      {0xC097CE7BC90715B3, 56, 36},
+      {0x8F7E32CE7BEA5C70, 83, 44},
+      {0xD5D238A4ABE98068, 109, 52},
+      {0x9F4F2726179A2245, 136, 60},
+      {0xED63A231D4C4FB27, 162, 68},
+      {0xB0DE65388CC8ADA8, 189, 76},
+      {0x83C7088E1AAB65DB, 216, 84},
+      {0xC45D1DF942711D9A, 242, 92},
+      {0x924D692CA61BE758, 269, 100},
+      {0xDA01EE641A708DEA, 295, 108},
+      {0xA26DA3999AEF774A, 322, 116},
+      {0xF209787BB47D6B85, 348, 124},
+      {0xB454E4A179DD1877, 375, 132},
+      {0x865B86925B9BC5C2, 402, 140},
+      {0xC83553C5C8965D3D, 428, 148},
+      {0x952AB45CFA97A0B3, 455, 156},
+      {0xDE469FBD99A05FE3, 481, 164},
+      {0xA59BC234DB398C25, 508, 172},
+      {0xF6C69A72A3989F5C, 534, 180},
+      {0xB7DCBF5354E9BECE, 561, 188},
+      {0x88FCF317F22241E2, 588, 196},
+      {0xCC20CE9BD35C78A5, 614, 204},
+      {0x98165AF37B2153DF, 641, 212},
+      {0xE2A0B5DC971F303A, 667, 220},
+      {0xA8D9D1535CE3B396, 694, 228},
+      {0xFB9B7CD9A4A7443C, 720, 236},
+      {0xBB764C4CA7A44410, 747, 244},
+      {0x8BAB8EEFB6409C1A, 774, 252},
+      {0xD01FEF10A657842C, 800, 260},
+      {0x9B10A4E5E9913129, 827, 268},
+      {0xE7109BFBA19C0C9D, 853, 276},
+      {0xAC2820D9623BF429, 880, 284},
+      {0x80444B5E7AA7CF85, 907, 292},
+      {0xBF21E44003ACDD2D, 933, 300},
+      {0x8E679C2F5E44FF8F, 960, 308},
+      {0xD433179D9C8CB841, 986, 316},
+      {0x9E19DB92B4E31BA9, 1013, 324},
+  }};
+
+  /*
+   * binary exponents of scaled boundaries land in [alpha, gamma],
+   * so digits split into a 32-bit integral and 64-bit fractional part
+   */
+  constexpr int const alpha = -60;
+  constexpr int const gamma = -32;
+
+  inline cached_power cached_power_for(int e) noexcept
+  {
+    // k = ceil((alpha - e - 1) * log10(2))
+    int const f = alpha - e - 1;
+    int const k = (f * 78913) / (1 << 18) + static_cast<int>(f > 0);
+    auto const index = (-min_decimal_exponent + k + (decimal_exponent_step - 1)) /
+                       decimal_exponent_step;
+    return cached_powers[static_cast<std::size_t>(index)];
+  }
+
+  inline int largest_pow10(std::uint32_t n, std::uint32_t& pow10) noexcept
+  {
+    constexpr std::array<std::uint32_t, 10> const powers = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+    int k = 10;
+    while (k > 1 && n < powers[static_cast<std::size_t>(k - 1)]) --k;
+    pow10 = powers[static_cast<std::size_t>(k - 1)];
+    return k;
+  }
+
+  inline void round(char* buffer,
+                    int length,
+                    std::uint64_t dist,
+                    std::uint64_t delta,
+                    std::uint64_t rest,
+                    std::uint64_t ten_k) noexcept
+  {
+    // move the last digit towards w while staying inside the rounding interval
+    while (rest < dist && delta - rest >= ten_k &&
+           (rest + ten_k < dist || dist - rest > rest + ten_k - dist))
+    {
+      buffer[length - 1]--;
+      rest += ten_k;
+    }
+  }
+
+  inline void digit_gen(char* buffer,
+                        int& length,
+                        int& decimal_exponent,
+                        diyfp m_minus,
+                        diyfp w,
+                        diyfp m_plus) noexcept
+  {
+    auto const one = diyfp(std::uint64_t{1} << -m_plus.e, m_plus.e);
+    auto delta = diyfp::sub(m_plus, m_minus).f;
+    auto dist = diyfp::sub(m_plus, w).f;
+
+    auto p1 = static_cast<std::uint32_t>(m_plus.f >> -one.e);
+    auto p2 = m_plus.f & (one.f - 1);
+
+    std::uint32_t pow10 = 0;
+    int n = largest_pow10(p1, pow10);
+    while (n > 0)
+    {
+      auto const d = p1 / pow10;
+      p1 %= pow10;
+      buffer[length++] = static_cast<char>('0' + d);
+      --n;
+      auto const rest = (std::uint64_t{p1} << -one.e) + p2;
+      if (rest <= delta)
+      {
+        decimal_exponent += n;
+        round(buffer, length, dist, delta, rest, std::uint64_t{pow10} << -one.e);
+        return;
+      }
+      pow10 /= 10;
+    }
+
+    int m = 0;
+    while (true)
+    {
+      p2 *= 10;
+      auto const d = p2 >> -one.e;
+      p2 &= one.f - 1;
+      buffer[length++] = static_cast<char>('0' + d);
+      ++m;
+      delta *= 10;
+      dist *= 10;
+      if (p2 <= delta) break;
+    }
+    decimal_exponent -= m;
+    round(buffer, length, dist, delta, p2, one.f);
+  }
+
+  /*
+   * shortest digits of positive finite value; value == digits * 10^decimal_exponent
+   */
+  inline void grisu2(char* buffer, int& length, int& decimal_exponent, double value) noexcept
+  {
+    auto const b = compute_boundaries(value);
+    auto const cached = cached_power_for(b.plus.e);
+    auto const c_minus_k = diyfp(cached.f, cached.e);
+
+    auto const w = diyfp::mul(b.w, c_minus_k);
+    auto const w_minus = diyfp::mul(b.minus, c_minus_k);
+    auto const w_plus = diyfp::mul(b.plus, c_minus_k);
+
+    // shrink the interval by one ulp of the imprecise multiplication on both sides
+    auto const m_minus = diyfp(w_minus.f + 1, w_minus.e);
+    auto const m_plus = diyfp(w_plus.f - 1, w_plus.e);
+
+    length = 0;
+    decimal_exponent = -cached.k;
+    digit_gen(buffer, length, decimal_exponent, m_minus, w, m_plus);
+  }
+
+  inline char* append_exponent(char* buffer, int e) noexcept
+  {
+    if (e < 0)
+    {
+      e = -e;
+      *buffer++ = '-';
+    }
+    auto const k = static_cast<std::uint32_t>(e);
+    if (k >= 100)
+    {
+      *buffer++ = static_cast<char>('0' + k / 100);
+      *buffer++ = static_cast<char>('0' + k / 10 % 10);
+    }
+    else if (k >= 10)
+      *buffer++ = static_cast<char>('0' + k / 10);
+    *buffer++ = static_cast<char>('0' + k % 10);
+    return buffer;
+  }
+
+  /*
+   * lays out digits in fixed or scientific notation, keeping a decimal
+   * point or an exponent so that the text reads back as a floating point value
+   */
+  inline char* format(char* buffer, int length, int decimal_exponent) noexcept
+  {
+    constexpr int const min_exp = -4;
+    constexpr int const max_exp = std::numeric_limits<double>::digits10;
+
+    auto const k = length;
+    auto const n = length + decimal_exponent;
+    auto const size = [](int x) { return static_cast<std::size_t>(x); };
+
+    if (k <= n && n <= max_exp)
+    {
+      // digits[000].0
+      std::memset(buffer + k, '0', size(n - k));
+      buffer[n] = '.';
+      buffer[n + 1] = '0';
+      return buffer + n + 2;
+    }
+    if (0 < n && n <= max_exp)
+    {
+      // dig.its
+      std::memmove(buffer + n + 1, buffer + n, size(k - n));
+      buffer[n] = '.';
+      return buffer + k + 1;
+    }
+    if (min_exp < n && n <= 0)
+    {
+      // 0.[000]digits
+      std::memmove(buffer + 2 - n, buffer, size(k));
+      buffer[0] = '0';
+      buffer[1] = '.';
+      std::memset(buffer + 2, '0', size(-n));
+      return buffer + 2 - n + k;
+    }
+    if (k == 1)
+    {
+      // de123
+      buffer += 1;
+    }
+    else
+    {
+      // d.igitse123
+      std::memmove(buffer + 2, buffer + 1, size(k - 1));
+      buffer[1] = '.';
+      buffer += 1 + k;
+    }
+    *buffer++ = 'e';
+    return append_exponent(buffer, n - 1);
+  }
+
+  /*
+   * writes finite value to [first, first + max_length) and returns end of written text
+   */
+  constexpr std::size_t const max_length = 32;
+
+  inline char* to_chars(char* first, double value) noexcept
+  {
+    if (std::signbit(value))
+    {
+      value = -value;
+      *first++ = '-';
+    }
+    if (value == 0)
+    {
+      *first++ = '0';
+      *first++ = '.';
+      *first++ = '0';
+      return first;
+    }
+    int length = 0;
+    int decimal_exponent = 0;
+    grisu2(first, length, decimal_exponent, value);
+    return format(first, length, decimal_exponent);
+  }
+} // namespace cxx::detail::grisu
@@ -12,22 +12,112 @@ namespace
       std::void_t<decltype(std::declval<std::size_t&>() = (std::declval<T const&>().size()))>>
       : std::true_type {
   };
+
+  /*
+   * non-empty container
+   */
+  template <typename Json>
+  bool nested(typename Json::object const& x) noexcept
+  {
+    auto const* dict = std::get_if<typename Json::dictionary>(&x);
+    auto const* items = std::get_if<typename Json::array>(&x);
+    return (dict && !std::empty(*dict)) || (items && !std::empty(*items));
+  }
+
+  /*
+   * nesting of the destructors running on this thread, past the limit trees are released from
+   * an explicit stack instead
+   */
+  constexpr std::size_t max_depth = 256;
+  thread_local std::size_t depth = 0;
+
+  /*
+   * Walks the tree with an explicit stack and frees each container once its children hold
+   * no containers anymore, so the destructors it runs never recurse further than one level. An
+   * allocation failure leaves the rest to recursion.
+   */
+  template <typename Json>
+  void release(typename Json::object& root) noexcept
+  {
+    using object = typename Json::object;
+    struct frame {
+      object* node;
+      std::size_t next;
+    };
+    auto const child = [](object& x, std::size_t n) -> object& {
+      if (auto* dict = std::get_if<typename Json::dictionary>(&x))
+        return cxx::to_object(std::next(std::begin(*dict), n)->second);
+      return cxx::to_object(std::get<typename Json::array>(x)[n]);
+    };
+    auto const size = [](object const& x) {
+      if (auto const* dict = std::get_if<typename Json::dictionary>(&x)) return std::size(*dict);
+      return std::size(std::get<typename Json::array>(x));
+    };
+    try
+    {
+      std::vector<frame> stack;
+      stack.push_back({&root, 0});
+      while (!std::empty(stack))
+      {
+        auto& top = stack.back();
+        auto const last = size(*top.node);
+        while (top.next != last && !nested<Json>(child(*top.node, top.next))) ++top.next;
+        if (top.next == last)
+        {
+          top.node->template emplace<typename Json::null_t>();
+          stack.pop_back();
+        }
+        else
+          stack.push_back({&child(*top.node, top.next++), 0});
+      }
+    }
+    catch (...)
+    {
+    }
+  }
+
+  /*
+   * Out of line, flattened callers would otherwise inline the whole destructor recursion.
+   */
+  template <typename Json>
+  [[gnu::noinline]] void destroy(typename Json::object& x) noexcept
+  {
+    if (depth == max_depth) return release<Json>(x);
+    ++depth;
+    if (auto* dict = std::get_if<typename Json::dictionary>(&x))
+      dict->clear();
+    else
+      std::get<typename Json::array>(x).clear();
+    --depth;
+  }
 } // namespace
 
-[[gnu::flatten]] ::cxx::json::json(std::initializer_list<cxx::json::array::value_type> init)
-    : storage(cxx::json::array(std::move(init)))
+template <template <typename> typename Allocator>
+::cxx::basic_json<Allocator>::~basic_json()
+{
+  if (nested<basic_json>(storage)) destroy<basic_json>(storage);
+}
+
+template <template <typename> typename Allocator>
+[[gnu::flatten]] ::cxx::basic_json<Allocator>::basic_json(
+    std::initializer_list<typename basic_json::array::value_type> init)
+    : storage(array(std::move(init)))
 {
 }
 
-[[gnu::flatten]] ::cxx::json::json(std::initializer_list<cxx::json::byte_stream::value_type> init)
-    : storage(cxx::json::byte_stream(std::move(init)))
+template <template <typename> typename Allocator>
+[[gnu::flatten]] ::cxx::basic_json<Allocator>::basic_json(
+    std::initializer_list<typename basic_json::byte_stream::value_type> init)
+    : storage(byte_stream(std::move(init)))
 {
 }
 
-[[gnu::flatten]] ::cxx::json::json(std::initializer_list<std::pair<json::key const, json>> init)
-    : json()
+template <template <typename> typename Allocator>
+[[gnu::flatten]] ::cxx::basic_json<Allocator>::basic_json(
+    std::initializer_list<std::pair<json_base::key const, basic_json>> init)
+    : basic_json()
 {
-  auto& dict = cxx::get<cxx::json::dictionary>(*this);
+  auto& dict = cxx::get<dictionary>(*this);
   for (auto& [k, v] : init)
   {
     dict.emplace(std::piecewise_construct, std::forward_as_tuple(k.ptr, k.size),
@@ -35,47 +125,61 @@ namespace
   }
 }
 
-[[gnu::flatten]] auto ::cxx::json::operator=(
-    std::initializer_list<cxx::json::array::value_type> init) -> json&
+template <template <typename> typename Allocator>
+[[gnu::flatten]] auto ::cxx::basic_json<Allocator>::operator=(
+    std::initializer_list<typename basic_json::array::value_type> init) -> basic_json&
 {
-  return (*this = cxx::json(std::move(init)));
+  return (*this = basic_json(std::move(init)));
 }
 
-[[gnu::flatten]] auto ::cxx::json::operator=(
-    std::initializer_list<cxx::json::byte_stream::value_type> init) -> json&
+template <template <typename> typename Allocator>
+[[gnu::flatten]] auto ::cxx::basic_json<Allocator>::operator=(
+    std::initializer_list<typename basic_json::byte_stream::value_type> init) -> basic_json&
 {
-  return (*this = cxx::json(std::move(init)));
+  return (*this = basic_json(std::move(init)));
 }
 
-[[gnu::flatten]] auto ::cxx::json::operator=(
-    std::initializer_list<std::pair<json::key const, json>> init) -> json&
+template <template <typename> typename Allocator>
+[[gnu::flatten]] auto ::cxx::basic_json<Allocator>::operator=(
+    std::initializer_list<std::pair<json_base::key const, basic_json>> init) -> basic_json&
 {
-  return (*this = cxx::json(std::move(init)));
+  return (*this = basic_json(std::move(init)));
 }
 
-[[gnu::flatten]] auto ::cxx::json::operator[](std::string const& k) -> json&
+template <template <typename> typename Allocator>
+[[gnu::flatten]] auto ::cxx::basic_json<Allocator>::operator[](std::string const& k)
+    -> basic_json&
 {
-  return cxx::get<cxx::json::dictionary>(*this)[k];
+  auto& dict = cxx::get<dictionary>(*this);
+  auto const it = dict.find(std::string_view(k));
+  if (it != std::end(dict)) return it->second;
+  return dict.try_emplace(string(k, dict.get_allocator())).first->second;
 }
 
-[[gnu::flatten]] auto ::cxx::json::operator[](std::string const& k) const -> json const&
+template <template <typename> typename Allocator>
+[[gnu::flatten]] auto ::cxx::basic_json<Allocator>::operator[](std::string const& k) const
+    -> basic_json const&
 {
-  return cxx::get<cxx::json::dictionary>(*this).at(k);
+  return cxx::get<dictionary>(*this).at(std::string_view(k));
 }
 
-[[gnu::flatten]] auto ::cxx::json::operator[](std::size_t k) -> json&
+template <template <typename> typename Allocator>
+[[gnu::flatten]] auto ::cxx::basic_json<Allocator>::operator[](std::size_t k) -> basic_json&
 {
-  return cxx::get<cxx::json::array>(*this).at(k);
+  return cxx::get<array>(*this).at(k);
 }
 
-[[gnu::flatten]] auto ::cxx::json::operator[](std::size_t k) const -> json const&
+template <template <typename> typename Allocator>
+[[gnu::flatten]] auto ::cxx::basic_json<Allocator>::operator[](std::size_t k) const
+    -> basic_json const&
 {
-  return cxx::get<cxx::json::array>(*this).at(k);
+  return cxx::get<array>(*this).at(k);
 }
 
-[[gnu::flatten]] auto ::cxx::json::size() const noexcept -> std::size_t
+template <template <typename> typename Allocator>
+[[gnu::flatten]] auto ::cxx::basic_json<Allocator>::size() const noexcept -> std::size_t
 {
-  auto const func = cxx::overload{[](cxx::json::null_t) -> std::size_t { return 0; },
+  auto const func = cxx::overload{[](null_t) -> std::size_t { return 0; },
                                   [](auto const& x) -> std::size_t {
                                     if constexpr (has_size<decltype(x)>::value)
                                       return std::size(x);
@@ -85,16 +189,22 @@ namespace
   return cxx::visit(func, *this);
 }
 
-[[gnu::flatten]] bool ::cxx::json::empty() const noexcept
+template <template <typename> typename Allocator>
+[[gnu::flatten]] bool ::cxx::basic_json<Allocator>::empty() const noexcept
 {
   return size() == 0;
 }
-[[gnu::flatten]] bool ::cxx::operator==(json const& lhs, json const& rhs) noexcept
+
+template <template <typename> typename Allocator>
+[[gnu::flatten]] bool ::cxx::operator==(basic_json<Allocator> const& lhs,
+                                        basic_json<Allocator> const& rhs) noexcept
 {
   return to_object(lhs) == to_object(rhs);
 }
 
-[[gnu::flatten]] bool ::cxx::operator!=(json const& lhs, json const& rhs) noexcept
+template <template <typename> typename Allocator>
+[[gnu::flatten]] bool ::cxx::operator!=(basic_json<Allocator> const& lhs,
+                                        basic_json<Allocator> const& rhs) noexcept
 {
   return !(lhs == rhs);
 }
@@ -104,3 +214,11 @@ namespace
 {
   return std::pair<cxx::json::key const, cxx::json>{key, std::move(value)};
 }
+
+template struct cxx::basic_json<std::allocator>;
+template struct cxx::basic_json<std::pmr::polymorphic_allocator>;
+
+template bool cxx::operator==(json const&, json const&) noexcept;
+template bool cxx::operator!=(json const&, json const&) noexcept;
+template bool cxx::operator==(pmr::json const&, pmr::json const&) noexcept;
+template bool cxx::operator!=(pmr::json const&, pmr::json const&) noexcept;
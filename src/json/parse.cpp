@@ -0,0 +1,431 @@
+#include "inc/cxx/json.hpp"
+#include "src/codec.hpp"
+#include "src/json/scan.hpp"
+#include <array>
+#include <charconv>
+
+namespace
+{
+  using text_view = std::string_view;
+
+  template <typename Sink>
+  text_view parse(text_view, Sink, std::size_t = ::cxx::codec::max_nesting);
+
+  template <typename T>
+  struct quote {
+    using type = T;
+  };
+
+  template <typename T>
+  auto const emplace_to = [](cxx::by_ref<T> target) {
+    return [ref = cxx::by_ref(target)](auto&& x) {
+      if constexpr (std::is_same_v<T, cxx::json::array>)
+      { ref->emplace_back(std::forward<decltype(x)>(x)); }
+      else if constexpr (std::is_same_v<T, cxx::json>)
+      {
+        ref.get() = std::forward<decltype(x)>(x);
+      }
+      else
+      {
+        throw 1;
+      }
+    };
+  };
+
+  /*
+   * character classes of a json text, indexed by byte value
+   */
+  struct table {
+    static constexpr std::uint8_t space = 0x1;
+    static constexpr std::uint8_t digit = 0x2;
+
+    std::uint8_t flags[0x100] = {};
+
+    constexpr table() noexcept
+    {
+      for (auto c : {' ', '\t', '\n', '\r'}) flags[static_cast<std::uint8_t>(c)] |= space;
+      for (auto c = '0'; c <= '9'; ++c) flags[static_cast<std::uint8_t>(c)] |= digit;
+    }
+
+    constexpr bool is(std::uint8_t flag, char c) const noexcept
+    {
+      return flags[static_cast<std::uint8_t>(c)] & flag;
+    }
+  };
+  constexpr table const chars{};
+
+  [[gnu::always_inline]] inline text_view skip_whitespace(text_view text) noexcept
+  {
+    auto const* first = text.data();
+    auto const* const last = first + std::size(text);
+    while (first != last && chars.is(table::space, *first)) ++first;
+    text.remove_prefix(static_cast<std::size_t>(first - text.data()));
+    return text;
+  }
+
+  [[gnu::always_inline]] inline std::size_t find_special(text_view text) noexcept
+  {
+    return ::cxx::detail::scan::plain(text.data(), text.data() + std::size(text));
+  }
+
+  auto const expect = [](text_view text, char c, char const* what) -> text_view {
+    text = skip_whitespace(text);
+    if (std::empty(text)) throw cxx::parse_error("not enough data to parse json");
+    if (text.front() != c) throw cxx::parse_error(what);
+    text.remove_prefix(1);
+    return text;
+  };
+
+  [[gnu::flatten]] auto read_hex4(cxx::by_ref<text_view> text) -> std::uint32_t
+  {
+    if (std::size(text.c_ref()) < 4) throw cxx::parse_error("not enough data to parse json");
+    std::uint32_t code = 0;
+    for (auto const c : text->substr(0, 4))
+    {
+      code <<= 4;
+      if (c >= '0' && c <= '9')
+        code |= static_cast<std::uint32_t>(c - '0');
+      else if (c >= 'a' && c <= 'f')
+        code |= static_cast<std::uint32_t>(c - 'a' + 10);
+      else if (c >= 'A' && c <= 'F')
+        code |= static_cast<std::uint32_t>(c - 'A' + 10);
+      else
+        throw cxx::parse_error("invalid unicode escape sequence");
+    }
+    text->remove_prefix(4);
+    return code;
+  }
+
+  [[gnu::flatten]] void append_utf8(std::uint32_t code, cxx::by_ref<std::string> out)
+  {
+    if (code < 0x80)
+      out->push_back(static_cast<char>(code));
+    else if (code < 0x800)
+    {
+      out->push_back(static_cast<char>(0xc0 | (code >> 6)));
+      out->push_back(static_cast<char>(0x80 | (code & 0x3f)));
+    }
+    else if (code < 0x10000)
+    {
+      out->push_back(static_cast<char>(0xe0 | (code >> 12)));
+      out->push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3f)));
+      out->push_back(static_cast<char>(0x80 | (code & 0x3f)));
+    }
+    else
+    {
+      out->push_back(static_cast<char>(0xf0 | (code >> 18)));
+      out->push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3f)));
+      out->push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3f)));
+      out->push_back(static_cast<char>(0x80 | (code & 0x3f)));
+    }
+  }
+
+  [[gnu::flatten]] void unescape(cxx::by_ref<text_view> text, cxx::by_ref<std::string> out)
+  {
+    if (std::size(text.c_ref()) < 2) throw cxx::parse_error("not enough data to parse json");
+    auto const c = text->at(1);
+    text->remove_prefix(2);
+    switch (c)
+    {
+      case '"':
+      case '\\':
+      case '/':
+        out->push_back(c);
+        break;
+      case 'b':
+        out->push_back('\b');
+        break;
+      case 'f':
+        out->push_back('\f');
+        break;
+      case 'n':
+        out->push_back('\n');
+        break;
+      case 'r':
+        out->push_back('\r');
+        break;
+      case 't':
+        out->push_back('\t');
+        break;
+      case 'u':
+      {
+        auto code = read_hex4(cxx::by_ref(text));
+        if (code >= 0xdc00 && code <= 0xdfff)
+          throw cxx::parse_error("unpaired surrogate in unicode escape sequence");
+        if (code >= 0xd800 && code <= 0xdbff)
+        {
+          if (text->substr(0, 2) != "\\u")
+            throw cxx::parse_error("unpaired surrogate in unicode escape sequence");
+          text->remove_prefix(2);
+          auto const low = read_hex4(cxx::by_ref(text));
+          if (low < 0xdc00 || low > 0xdfff)
+            throw cxx::parse_error("unpaired surrogate in unicode escape sequence");
+          code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+        }
+        append_utf8(code, cxx::by_ref(out));
+        break;
+      }
+      default:
+        throw cxx::parse_error("invalid escape sequence");
+    }
+  }
+
+  template <typename Sink>
+  text_view parse(quote<std::string>, text_view text, Sink sink)
+  {
+    auto n = find_special(text);
+    if (n == std::size(text)) throw cxx::parse_error("not enough data to parse json");
+    if (text[n] == '"')
+    {
+      sink(text.substr(0, n));
+      return text.substr(n + 1);
+    }
+    std::string str(text.data(), n);
+    text.remove_prefix(n);
+    while (text.front() != '"')
+    {
+      if (text.front() != '\\') throw cxx::parse_error("unescaped control character in string");
+      unescape(cxx::by_ref(text), cxx::by_ref(str));
+      n = find_special(text);
+      if (n == std::size(text)) throw cxx::parse_error("not enough data to parse json");
+      str.append(text.data(), n);
+      text.remove_prefix(n);
+    }
+    sink(std::move(str));
+    return text.substr(1);
+  }
+
+  template <typename Sink>
+  text_view parse(quote<cxx::json::null_t>, text_view text, std::string_view literal, Sink sink)
+  {
+    if (text.substr(0, std::size(literal)) != literal)
+    {
+      if (std::size(text) < std::size(literal) && literal.substr(0, std::size(text)) == text)
+        throw cxx::parse_error("not enough data to parse json");
+      throw cxx::parse_error("invalid literal");
+    }
+    if (literal.front() == 'n')
+      sink(cxx::json::null);
+    else
+      sink(literal.front() == 't');
+    return text.substr(std::size(literal));
+  }
+
+  [[gnu::flatten]] auto to_double(char const* first, char const* last, int magnitude) -> double
+  {
+    double d = 0.0;
+    auto const [ptr, ec] = std::from_chars(first, last, d);
+    if (ec == std::errc::result_out_of_range)
+    {
+      if (magnitude > 0) throw cxx::parse_error("number out of range");
+      return (*first == '-') ? -0.0 : 0.0;
+    }
+    if (ec != std::errc() || ptr != last) throw cxx::parse_error("invalid number");
+    return d;
+  }
+
+  template <typename Sink>
+  text_view parse(quote<double>, text_view text, Sink sink)
+  {
+    constexpr std::array<double, 23> const exact = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    constexpr std::uint64_t const max_exact = std::uint64_t(1) << 53;
+
+    auto const* const first = text.data();
+    auto const* const last = first + std::size(text);
+    auto const* it = first;
+    auto const truncated = [&it, last] {
+      if (it == last) throw cxx::parse_error("not enough data to parse json");
+    };
+    auto const digit = [&it, last] { return it != last && chars.is(table::digit, *it); };
+
+    bool const negative = (*it == '-');
+    if (negative) ++it;
+    truncated();
+    if (!chars.is(table::digit, *it)) throw cxx::parse_error("invalid number");
+
+    std::uint64_t mantissa = 0;
+    int significant = 0; // digits accumulated in mantissa, leading zeros excluded
+    int dropped = 0;     // digits which did not fit into mantissa
+    auto const accumulate = [&mantissa, &significant, &dropped](char c) {
+      if (significant < 19)
+      {
+        mantissa = mantissa * 10 + static_cast<std::uint64_t>(c - '0');
+        significant += (mantissa != 0);
+      }
+      else
+        ++dropped;
+    };
+
+    if (*it == '0')
+      ++it;
+    else
+      while (digit()) accumulate(*it++);
+    int exponent = dropped;
+
+    bool integral = true;
+    if (it != last && *it == '.')
+    {
+      integral = false;
+      ++it;
+      truncated();
+      if (!digit()) throw cxx::parse_error("invalid number");
+      while (digit())
+      {
+        auto const before = dropped;
+        accumulate(*it++);
+        exponent -= (dropped == before);
+      }
+    }
+    if (it != last && (*it == 'e' || *it == 'E'))
+    {
+      integral = false;
+      ++it;
+      truncated();
+      bool const minus = (*it == '-');
+      if (minus || *it == '+') ++it;
+      truncated();
+      if (!digit()) throw cxx::parse_error("invalid number");
+      int e = 0;
+      while (digit())
+      {
+        if (e < 100000) e = e * 10 + (*it - '0');
+        ++it;
+      }
+      exponent += minus ? -e : e;
+    }
+
+    auto const leftovers = text.substr(static_cast<std::size_t>(it - first));
+    if (integral && dropped == 0)
+    {
+      if (!negative && mantissa <= std::numeric_limits<std::int64_t>::max())
+      {
+        sink(static_cast<std::int64_t>(mantissa));
+        return leftovers;
+      }
+      if (negative && mantissa - 1 <= std::numeric_limits<std::int64_t>::max())
+      {
+        sink(-static_cast<std::int64_t>(mantissa - 1) - 1);
+        return leftovers;
+      }
+    }
+    if (dropped == 0 && mantissa <= max_exact && exponent >= -22 && exponent <= 22)
+    {
+      auto d = static_cast<double>(mantissa);
+      d = (exponent < 0) ? d / exact[static_cast<std::size_t>(-exponent)]
+                         : d * exact[static_cast<std::size_t>(exponent)];
+      sink(negative ? -d : d);
+      return leftovers;
+    }
+    sink(to_double(first, it, exponent + significant));
+    return leftovers;
+  }
+
+  template <typename Sink>
+  text_view parse(quote<cxx::json::array>, text_view text, Sink sink, std::size_t level)
+  {
+    if (--level == 0) throw cxx::parse_error("nesting level exceeds implementation limit");
+    cxx::json::array array;
+    text = skip_whitespace(text);
+    if (!std::empty(text) && text.front() == ']')
+    {
+      sink(std::move(array));
+      return text.substr(1);
+    }
+    while (true)
+    {
+      text = parse(text, emplace_to<cxx::json::array>(cxx::by_ref(array)), level);
+      text = skip_whitespace(text);
+      if (std::empty(text)) throw cxx::parse_error("not enough data to parse json");
+      auto const c = text.front();
+      text.remove_prefix(1);
+      if (c == ']') break;
+      if (c != ',') throw cxx::parse_error("expected ',' or ']' after array item");
+    }
+    sink(std::move(array));
+    return text;
+  }
+
+  template <typename Sink>
+  text_view parse(quote<cxx::json::dictionary>, text_view text, Sink sink, std::size_t level)
+  {
+    if (--level == 0) throw cxx::parse_error("nesting level exceeds implementation limit");
+    cxx::json::dictionary dict;
+    text = skip_whitespace(text);
+    if (!std::empty(text) && text.front() == '}')
+    {
+      sink(std::move(dict));
+      return text.substr(1);
+    }
+    while (true)
+    {
+      text = expect(text, '"', "expected string as dictionary key");
+      std::string key;
+      text = parse(quote<std::string>{}, text,
+                   [&key](auto&& x) { key = std::forward<decltype(x)>(x); });
+      text = expect(text, ':', "expected ':' after dictionary key");
+      cxx::json value;
+      text = parse(text, emplace_to<cxx::json>(cxx::by_ref(value)), level);
+      dict.try_emplace(std::move(key), std::move(value));
+      text = skip_whitespace(text);
+      if (std::empty(text)) throw cxx::parse_error("not enough data to parse json");
+      auto const c = text.front();
+      text.remove_prefix(1);
+      if (c == '}') break;
+      if (c != ',') throw cxx::parse_error("expected ',' or '}' after dictionary item");
+    }
+    sink(std::move(dict));
+    return text;
+  }
+
+  template <typename Sink>
+  text_view parse(text_view text, Sink sink, std::size_t level)
+  {
+    text = skip_whitespace(text);
+    if (std::empty(text)) throw cxx::parse_error("not enough data to parse json");
+    switch (text.front())
+    {
+      case '{':
+        return parse(quote<cxx::json::dictionary>{}, text.substr(1), sink, level);
+      case '[':
+        return parse(quote<cxx::json::array>{}, text.substr(1), sink, level);
+      case '"':
+        return parse(quote<std::string>{}, text.substr(1), sink);
+      case 't':
+        return parse(quote<cxx::json::null_t>{}, text, "true", sink);
+      case 'f':
+        return parse(quote<cxx::json::null_t>{}, text, "false", sink);
+      case 'n':
+        return parse(quote<cxx::json::null_t>{}, text, "null", sink);
+      case '-':
+      case '0':
+      case '1':
+      case '2':
+      case '3':
+      case '4':
+      case '5':
+      case '6':
+      case '7':
+      case '8':
+      case '9':
+        return parse(quote<double>{}, text, sink);
+      default:
+        throw cxx::parse_error("unexpected character in json text");
+    }
+  }
+} // namespace
+
+auto ::cxx::parse(std::string_view text) -> json
+{
+  auto json = parse(cxx::by_ref(text));
+  if (!std::empty(text)) throw cxx::parse_error("unexpected data after json text");
+  return json;
+}
+
+auto ::cxx::parse(cxx::by_ref<std::string_view> text) -> json
+{
+  cxx::json json;
+  text = skip_whitespace(::parse(text.c_ref(), emplace_to<cxx::json>(cxx::by_ref(json))));
+  return json;
+}
@@ -0,0 +1,130 @@
+#pragma once
+#include "inc/cxx/json.hpp"
+#include "inc/cxx/by_ref.hpp"
+#include "src/codec.hpp"
+#include <list>
+
+namespace cxx::detail
+{
+  /*
+   * stands in for an array decoded over an existing one, items are overwritten in place and
+   * the ones left over are dropped once the array is complete
+   */
+  struct reuse_array {
+    using size_type = std::size_t;
+
+    explicit reuse_array(json* node)
+    {
+      if (!cxx::holds_alternative<json::array>(*node)) *node = json::array();
+      items = &cxx::get<json::array>(*node);
+    }
+    size_type size() const noexcept { return count; }
+    void reserve(size_type n) { items->reserve(n); }
+
+    json* next()
+    {
+      if (count == std::size(*items)) items->emplace_back();
+      return &(*items)[count++];
+    }
+
+    void finish()
+    {
+      items->erase(std::begin(*items) + static_cast<std::ptrdiff_t>(count), std::end(*items));
+    }
+
+    json::array* items;
+    size_type count = 0;
+  };
+
+  /*
+   * stands in for a dictionary decoded over an existing one, the first count items are the
+   * keys decoded so far; a key between them is a duplicate and its value is dropped
+   */
+  struct reuse_dictionary {
+    using size_type = std::size_t;
+
+    explicit reuse_dictionary(json* node)
+    {
+      if (!cxx::holds_alternative<json::dictionary>(*node)) *node = json::dictionary();
+      items = &cxx::get<json::dictionary>(*node);
+    }
+    size_type size() const noexcept { return count; }
+    void reserve(size_type n) { items->reserve(n); }
+
+    json* slot(std::string_view key)
+    {
+      auto const first = std::begin(*items);
+      auto at = items->lower_bound(key);
+      auto const seen = first + static_cast<std::ptrdiff_t>(count);
+      if (at < seen)
+      {
+        if (at->first == key) return &(duplicate = json::null);
+      }
+      else
+        at = items->erase(seen, at);
+      if (at == std::end(*items) || at->first != key)
+        at = items->try_emplace(at, std::string(key));
+      ++count;
+      return &at->second;
+    }
+
+    void finish()
+    {
+      items->erase(std::begin(*items) + static_cast<std::ptrdiff_t>(count), std::end(*items));
+    }
+
+    json::dictionary* items;
+    size_type count = 0;
+    json duplicate;
+  };
+
+  /*
+   * node type seen by the decoders when they overwrite an existing cxx::json, the allocator
+   * is the node being written
+   */
+  struct reuse_json {
+    using allocator = json*;
+    using string = std::string;
+    using byte_stream = json::byte_stream;
+    using array = reuse_array;
+    using dictionary = reuse_dictionary;
+  };
+
+  /*
+   * strings and byte streams are assigned to the ones already in place, keeping their capacity
+   */
+  template <typename T>
+  auto reuse_sink(cxx::by_ref<T> target, std::string_view key)
+  {
+    json* node = nullptr;
+    if constexpr (std::is_same_v<T, reuse_array>)
+      node = target->next();
+    else if constexpr (std::is_same_v<T, reuse_dictionary>)
+      node = target->slot(key);
+    else
+      node = &target.get();
+    auto const bytes = [node]() -> json::byte_stream& {
+      if (!cxx::holds_alternative<json::byte_stream>(*node)) *node = json::byte_stream();
+      return cxx::get<json::byte_stream>(*node);
+    };
+    auto const impl = cxx::overload{
+        [node](std::string_view x) {
+          if (auto* str = std::get_if<std::string>(&cxx::to_object(*node)))
+            str->assign(x);
+          else
+            *node = std::string(x);
+        },
+        [bytes](json::byte_view x) { bytes().assign(x.data(), x.data() + std::size(x)); },
+        [bytes](std::list<json::byte_view> const& chunks, std::size_t length) {
+          auto& stream = bytes();
+          stream.clear();
+          stream.reserve(length);
+          for (auto const& x : chunks)
+            stream.insert(std::end(stream), x.data(), x.data() + std::size(x));
+        },
+        [](reuse_array&& x) { x.finish(); },
+        [](reuse_dictionary&& x) { x.finish(); },
+        [node](auto&& x) { *node = std::forward<decltype(x)>(x); }};
+    return ::cxx::codec::sink<reuse_json, std::decay_t<decltype(impl)>>{impl, node};
+  }
+} // namespace cxx::detail
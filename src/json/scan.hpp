@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/*
+ * Block scanning for characters which json strings can not carry verbatim:
+ * quotation mark, reverse solidus and control characters below 0x20.
+ * Both text parser and serializer use it to skip over clean runs.
+ */
+namespace cxx::detail::scan
+{
+  [[gnu::always_inline]] inline bool special(char c) noexcept
+  {
+    auto const x = static_cast<std::uint8_t>(c);
+    return x < 0x20 || x == '"' || x == '\\';
+  }
+
+#if defined(__AVX2__)
+  [[gnu::always_inline]] inline std::uint32_t mask32(char const* p) noexcept
+  {
+    auto const x = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p));
+    auto const quote = _mm256_cmpeq_epi8(x, _mm256_set1_epi8('"'));
+    auto const backslash = _mm256_cmpeq_epi8(x, _mm256_set1_epi8('\\'));
+    auto const control = _mm256_cmpeq_epi8(_mm256_min_epu8(x, _mm256_set1_epi8(0x1f)), x);
+    auto const hits = _mm256_or_si256(_mm256_or_si256(quote, backslash), control);
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(hits));
+  }
+#endif
+
+#if defined(__SSE2__)
+  [[gnu::always_inline]] inline std::uint32_t mask16(char const* p) noexcept
+  {
+    auto const x = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+    auto const quote = _mm_cmpeq_epi8(x, _mm_set1_epi8('"'));
+    auto const backslash = _mm_cmpeq_epi8(x, _mm_set1_epi8('\\'));
+    auto const control = _mm_cmpeq_epi8(_mm_min_epu8(x, _mm_set1_epi8(0x1f)), x);
+    auto const hits = _mm_or_si128(_mm_or_si128(quote, backslash), control);
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(hits));
+  }
+#endif
+
+  /*
+   * number of leading characters in [first, last) which need no escaping
+   */
+  [[gnu::always_inline]] inline std::size_t plain(char const* first, char const* last) noexcept
+  {
+    auto const* it = first;
+#if defined(__AVX2__)
+    for (; last - it >= 32; it += 32)
+      if (auto const mask = mask32(it); mask != 0)
+        return static_cast<std::size_t>(it - first) + static_cast<std::size_t>(__builtin_ctz(mask));
+#endif
+#if defined(__SSE2__)
+    for (; last - it >= 16; it += 16)
+      if (auto const mask = mask16(it); mask != 0)
+        return static_cast<std::size_t>(it - first) + static_cast<std::size_t>(__builtin_ctz(mask));
+#endif
+    while (it != last && !special(*it)) ++it;
+    return static_cast<std::size_t>(it - first);
+  }
+} // namespace cxx::detail::scan
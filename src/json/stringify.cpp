@@ -1,46 +1,284 @@
 #include "inc/cxx/json.hpp"
-#include <iomanip>
-#include <sstream>
+#include "src/json/grisu.hpp"
+#include "src/json/scan.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ostream>
+#include <system_error>
+#include <unistd.h>
 
 namespace
 {
-  auto const serializer =
-      cxx::overload{[](cxx::json::null_t) -> std::string { return "null"; },
-                    [](std::int64_t x) -> std::string { return std::to_string(x); },
-                    [](double x) -> std::string { return std::to_string(x); },
-                    [](bool x) -> std::string { return x ? "true" : "false"; },
-                    [](std::string const& x) -> std::string {
-                      std::stringstream ss;
-                      ss << std::quoted(x);
-                      return ss.str();
-                    },
-                    [](cxx::json::array const& array) -> std::string {
-                      if (std::empty(array)) return "[]";
-                      std::stringstream ss;
-                      ss << "[";
-                      for (auto const& x : array) ss << cxx::to_string(x) << ", ";
-                      auto ret = ss.str();
-                      ret.pop_back();
-                      ret.back() = ']';
-                      return ret;
-                    },
-                    [](cxx::json::dictionary const& dict) -> std::string {
-                      if (std::empty(dict)) return "{}";
-                      std::stringstream ss;
-                      ss << "{";
-                      for (auto const& [key, value] : dict)
-                      { ss << std::quoted(key) << ": " << cxx::to_string(value) << ", "; }
-                      auto ret = ss.str();
-                      ret.pop_back();
-                      ret.back() = '}';
-                      return ret;
-                    },
-                    [](cxx::json::byte_stream const&) -> std::string {
-                      throw std::invalid_argument("bytes are not JSON serializable");
-                    }};
+  /*
+   * two-digit lookup for integer formatting, "00" "01" ... "99"
+   */
+  constexpr char const digits[] = "00010203040506070809"
+                                  "10111213141516171819"
+                                  "20212223242526272829"
+                                  "30313233343536373839"
+                                  "40414243444546474849"
+                                  "50515253545556575859"
+                                  "60616263646566676869"
+                                  "70717273747576777879"
+                                  "80818283848586878889"
+                                  "90919293949596979899";
+
+  /*
+   * fixed size buffer in front of a stream or file descriptor, large writes bypass it
+   */
+  template <typename Sink>
+  class buffered
+  {
+  public:
+    explicit buffered(Sink s) : sink(std::move(s)), buffer(new char[capacity]) {}
+
+    void append(char const* data, std::size_t n)
+    {
+      if (n > capacity - size)
+      {
+        flush();
+        if (n >= capacity) return sink(data, n);
+      }
+      std::memcpy(buffer.get() + size, data, n);
+      size += n;
+    }
+
+    void push_back(char c)
+    {
+      if (size == capacity) flush();
+      buffer[size++] = c;
+    }
+
+    void flush()
+    {
+      if (size != 0) sink(buffer.get(), size);
+      size = 0;
+    }
+
+  private:
+    static constexpr std::size_t const capacity = 0x10000;
+
+    Sink sink;
+    std::unique_ptr<char[]> buffer;
+    std::size_t size = 0;
+  };
+
+  template <typename Sink>
+  buffered(Sink)->buffered<Sink>;
+
+  /*
+   *
+   */
+  template <typename Output>
+  class writer
+  {
+  public:
+    writer(cxx::by_ref<Output> o, cxx::layout l) : out(o), format(l) {}
+
+    [[gnu::noinline, gnu::flatten]] void write(cxx::json const& json)
+    {
+      cxx::visit([this](auto const& x) { write(x); }, json);
+    }
+
+  private:
+    [[gnu::always_inline]] inline void append(std::string_view x)
+    {
+      out->append(x.data(), std::size(x));
+    }
+
+    void newline()
+    {
+      constexpr char const spaces[] = "                                ";
+      out->push_back('\n');
+      for (auto n = depth * format.indent; n != 0;)
+      {
+        auto const chunk = std::min(n, sizeof(spaces) - 1);
+        out->append(spaces, chunk);
+        n -= chunk;
+      }
+    }
+
+    void open(char c)
+    {
+      out->push_back(c);
+      ++depth;
+      if (format.indent != 0) newline();
+    }
+
+    void close(char c)
+    {
+      --depth;
+      if (format.indent != 0) newline();
+      out->push_back(c);
+    }
+
+    void separator()
+    {
+      out->push_back(',');
+      if (format.indent != 0) newline();
+      else if (!format.compact)
+        out->push_back(' ');
+    }
+
+    void write(cxx::json::null_t) { append("null"); }
+
+    void write(bool x) { append(x ? "true" : "false"); }
+
+    void write(std::int64_t x)
+    {
+      char buffer[20];
+      auto* const last = buffer + sizeof(buffer);
+      auto* first = last;
+      auto n = (x < 0) ? (~static_cast<std::uint64_t>(x) + 1) : static_cast<std::uint64_t>(x);
+      while (n >= 100)
+      {
+        auto const i = (n % 100) * 2;
+        n /= 100;
+        *--first = digits[i + 1];
+        *--first = digits[i];
+      }
+      if (n >= 10)
+      {
+        auto const i = n * 2;
+        *--first = digits[i + 1];
+        *--first = digits[i];
+      }
+      else
+        *--first = static_cast<char>('0' + n);
+      if (x < 0) *--first = '-';
+      out->append(first, static_cast<std::size_t>(last - first));
+    }
+
+    void write(double x)
+    {
+      if (!std::isfinite(x)) return append("null");
+      char buffer[::cxx::detail::grisu::max_length];
+      auto const* const last = ::cxx::detail::grisu::to_chars(buffer, x);
+      out->append(buffer, static_cast<std::size_t>(last - buffer));
+    }
+
+    void escape(char c)
+    {
+      constexpr char const hex[] = "0123456789abcdef";
+      switch (c)
+      {
+        case '"':
+          return append("\\\"");
+        case '\\':
+          return append("\\\\");
+        case '\b':
+          return append("\\b");
+        case '\f':
+          return append("\\f");
+        case '\n':
+          return append("\\n");
+        case '\r':
+          return append("\\r");
+        case '\t':
+          return append("\\t");
+        default:
+        {
+          auto const x = static_cast<std::uint8_t>(c);
+          char const code[] = {'\\', 'u', '0', '0', hex[x >> 4], hex[x & 0xf]};
+          return append(std::string_view(code, sizeof(code)));
+        }
+      }
+    }
+
+    void write(std::string const& x)
+    {
+      out->push_back('"');
+      auto const* first = x.data();
+      auto const* const last = first + std::size(x);
+      while (true)
+      {
+        auto const n = ::cxx::detail::scan::plain(first, last);
+        out->append(first, n);
+        first += n;
+        if (first == last) break;
+        escape(*first++);
+      }
+      out->push_back('"');
+    }
+
+    void write(cxx::json::array const& x)
+    {
+      if (std::empty(x)) return append("[]");
+      open('[');
+      for (auto it = std::begin(x); it != std::end(x); ++it)
+      {
+        if (it != std::begin(x)) separator();
+        write(*it);
+      }
+      close(']');
+    }
+
+    void write(cxx::json::dictionary const& x)
+    {
+      if (std::empty(x)) return append("{}");
+      open('{');
+      for (auto it = std::begin(x); it != std::end(x); ++it)
+      {
+        if (it != std::begin(x)) separator();
+        write(it->first);
+        append(format.compact ? ":" : ": ");
+        write(it->second);
+      }
+      close('}');
+    }
+
+    void write(cxx::json::byte_stream const&)
+    {
+      throw std::invalid_argument("bytes are not JSON serializable");
+    }
+
+    cxx::by_ref<Output> out;
+    cxx::layout const format;
+    std::size_t depth = 0;
+  };
+
+  template <typename Output>
+  writer(cxx::by_ref<Output>, cxx::layout)->writer<Output>;
+} // namespace
+
+auto ::cxx::to_string(json const& object, layout format) -> std::string
+{
+  std::string ret;
+  ::cxx::to_string(object, cxx::by_ref(ret), format);
+  return ret;
+}
+
+void ::cxx::to_string(json const& object, cxx::by_ref<std::string> out, layout format)
+{
+  out->clear();
+  writer(cxx::by_ref(out), format).write(object);
+}
+
+void ::cxx::write(json const& object, std::ostream& os, layout format)
+{
+  auto out = buffered([&os](char const* data, std::size_t n) {
+    os.write(data, static_cast<std::streamsize>(n));
+  });
+  writer(cxx::by_ref(out), format).write(object);
+  out.flush();
 }
 
-auto ::cxx::to_string(json const& object) -> std::string
+void ::cxx::write(json const& object, int fd, layout format)
 {
-  return cxx::visit(serializer, object);
+  auto out = buffered([fd](char const* data, std::size_t n) {
+    while (n != 0)
+    {
+      auto const written = ::write(fd, data, n);
+      if (written < 0)
+      {
+        if (errno == EINTR) continue;
+        throw std::system_error(errno, std::generic_category(), "cxx::write");
+      }
+      data += written;
+      n -= static_cast<std::size_t>(written);
+    }
+  });
+  writer(cxx::by_ref(out), format).write(object);
+  out.flush();
 }
@@ -0,0 +1,67 @@
+#include "inc/cxx/json_view.hpp"
+
+namespace
+{
+  template <typename T, typename = void>
+  struct has_size : std::false_type {
+  };
+
+  template <typename T>
+  struct has_size<
+      T,
+      std::void_t<decltype(std::declval<std::size_t&>() = (std::declval<T const&>().size()))>>
+      : std::true_type {
+  };
+
+  auto const owned = cxx::overload{
+      [](cxx::json_view::dictionary const& x) -> cxx::json {
+        cxx::json::dictionary ret;
+        ret.reserve(std::size(x));
+        for (auto const& [key, value] : x)
+          ret.try_emplace(std::end(ret), std::string(key), value.to_owned());
+        return ret;
+      },
+      [](cxx::json_view::array const& x) -> cxx::json {
+        cxx::json::array ret;
+        ret.reserve(std::size(x));
+        for (auto const& value : x) ret.push_back(value.to_owned());
+        return ret;
+      },
+      [](std::string_view x) -> cxx::json { return std::string(x); },
+      [](cxx::json_view::byte_stream x) -> cxx::json {
+        return cxx::json::byte_stream(std::begin(x), std::end(x));
+      },
+      [](auto const& x) -> cxx::json { return x; }};
+} // namespace
+
+[[gnu::flatten]] auto ::cxx::json_view::operator[](std::string_view k) const -> json_view const&
+{
+  return cxx::get<dictionary>(*this).at(k);
+}
+
+[[gnu::flatten]] auto ::cxx::json_view::operator[](std::size_t k) const -> json_view const&
+{
+  return cxx::get<array>(*this).at(k);
+}
+
+[[gnu::flatten]] auto ::cxx::json_view::size() const noexcept -> std::size_t
+{
+  auto const func = cxx::overload{[](null_t) -> std::size_t { return 0; },
+                                  [](auto const& x) -> std::size_t {
+                                    if constexpr (has_size<decltype(x)>::value)
+                                      return std::size(x);
+                                    else
+                                      return 1;
+                                  }};
+  return cxx::visit(func, *this);
+}
+
+[[gnu::flatten]] bool ::cxx::json_view::empty() const noexcept
+{
+  return size() == 0;
+}
+
+auto ::cxx::json_view::to_owned() const -> json
+{
+  return cxx::visit(owned, *this);
+}
@@ -0,0 +1,30 @@
+#include "inc/cxx/lazy.hpp"
+
+auto ::cxx::lazy::operator[](std::string const& k) const -> lazy const&
+{
+  return std::get<dictionary>(parts()).at(std::string_view(k));
+}
+
+auto ::cxx::lazy::operator[](std::size_t k) const -> lazy const&
+{
+  return std::get<array>(parts()).at(k);
+}
+
+auto ::cxx::lazy::decoded() const -> json const&
+{
+  if (!value) value.emplace(codec->decode(bytes));
+  return *value;
+}
+
+auto ::cxx::lazy::size() const -> std::size_t
+{
+  auto const func = cxx::overload{[this](std::monostate) { return std::size(decoded()); },
+                                  [](auto const& x) { return std::size(x); }};
+  return std::visit(func, parts());
+}
+
+auto ::cxx::lazy::parts() const -> items const&
+{
+  if (!split) split.emplace(codec->split(bytes, *codec));
+  return *split;
+}
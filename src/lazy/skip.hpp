@@ -0,0 +1,43 @@
+#pragma once
+#include "inc/cxx/json.hpp"
+#include "inc/cxx/by_ref.hpp"
+#include "src/codec.hpp"
+
+namespace cxx::detail
+{
+  /*
+   * stands in for a container whose items are only counted
+   */
+  struct skipped {
+    using size_type = std::size_t;
+
+    template <typename Allocator>
+    explicit skipped(Allocator const&) noexcept
+    {
+    }
+    size_type size() const noexcept { return count; }
+    void reserve(size_type) const noexcept {}
+
+    size_type count = 0;
+  };
+
+  /*
+   * node type seen by the decoders when they only look for the end of a node
+   */
+  struct skip_json {
+    using allocator = std::allocator<char>;
+    using string = std::string;
+    using byte_stream = json::byte_view;
+    using array = skipped;
+    using dictionary = skipped;
+  };
+
+  /*
+   *
+   */
+  inline auto skip_sink(cxx::by_ref<skipped> target)
+  {
+    auto const impl = [ref = cxx::by_ref(target)](auto&&...) { ++ref->count; };
+    return ::cxx::codec::sink<skip_json, std::decay_t<decltype(impl)>>{impl, {}};
+  }
+} // namespace cxx::detail
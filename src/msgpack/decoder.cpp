@@ -1,5 +1,8 @@
 #include "inc/cxx/msgpack.hpp"
 #include "src/codec.hpp"
+#include "src/json/reuse.hpp"
+#include "src/lazy/skip.hpp"
+#include "src/tape/builder.hpp"
 
 namespace
 {
@@ -8,26 +11,44 @@ namespace
                              Sink,
                              std::size_t = ::cxx::codec::max_nesting);
 
-  template <typename T>
-  auto const emplace_to = [](cxx::by_ref<T> target, std::string_view key = std::string_view()) {
-    using key_type = cxx::json::dictionary::key_type;
-    return [ref = cxx::by_ref(target), key](auto&& x) {
+  template <typename Json, typename T>
+  auto const emplace_to_tree = [](cxx::by_ref<T> target,
+                                  typename Json::allocator const& alloc,
+                                  std::string_view key) {
+    auto impl = [ref = cxx::by_ref(target), alloc, key](auto&& x) {
       (void)key;
-      if constexpr (std::is_same_v<T, cxx::json::array>)
-      { ref->emplace_back(std::forward<decltype(x)>(x)); }
-      else if constexpr (std::is_same_v<T, cxx::json::dictionary>)
+      auto&& value = ::cxx::codec::own<Json>(std::forward<decltype(x)>(x), alloc);
+      if constexpr (std::is_same_v<T, typename Json::array>)
+      { ref->emplace_back(std::forward<decltype(value)>(value)); }
+      else if constexpr (std::is_same_v<T, typename Json::dictionary>)
       {
-        ref->try_emplace(key_type(key), std::forward<decltype(x)>(x));
+        ref->try_emplace(::cxx::codec::own<Json>(key, alloc),
+                         std::forward<decltype(value)>(value));
       }
-      else if constexpr (std::is_same_v<T, cxx::json>)
+      else if constexpr (std::is_same_v<T, Json>)
       {
-        ref.get() = std::forward<decltype(x)>(x);
+        ref.get() = std::forward<decltype(value)>(value);
       }
       else
       {
         throw 1;
       }
     };
+    return ::cxx::codec::sink<Json, decltype(impl)>{impl, alloc};
+  };
+
+  template <typename Json, typename T>
+  auto const emplace_to = [](cxx::by_ref<T> target,
+                             typename Json::allocator const& alloc,
+                             std::string_view key = std::string_view()) {
+    if constexpr (std::is_same_v<Json, cxx::detail::tape_json>)
+      return cxx::detail::tape_sink(cxx::by_ref(target), alloc, key);
+    else if constexpr (std::is_same_v<Json, cxx::detail::skip_json>)
+      return cxx::detail::skip_sink(cxx::by_ref(target));
+    else if constexpr (std::is_same_v<Json, cxx::detail::reuse_json>)
+      return cxx::detail::reuse_sink(cxx::by_ref(target), key);
+    else
+      return emplace_to_tree<Json, T>(cxx::by_ref(target), alloc, key);
   };
 
   template <typename T>
@@ -168,10 +189,44 @@ namespace
     if (std::size(bytes) < size)
       throw cxx::msgpack::truncation_error("not enough data to decode json");
     auto const data = bytes.substr(0, size);
-    sink(cxx::json::byte_stream(std::begin(data), std::end(data)));
+    sink(data);
     return bytes.substr(size);
   }
 
+  auto array_size(cxx::codec::numbyte const init, cxx::by_ref<cxx::json::byte_view> bytes)
+      -> std::size_t
+  {
+    if ((init & 0xf0) == 0x90) return init & 0x0f;
+    std::size_t space = 1u << (init - 0xdb);
+    auto const s = static_cast<std::size_t>(read_int64_t<false>(space, bytes.c_ref()));
+    bytes->remove_prefix(space);
+    return s;
+  }
+
+  auto dictionary_size(cxx::codec::numbyte const init, cxx::by_ref<cxx::json::byte_view> bytes)
+      -> std::size_t
+  {
+    if ((init & 0xf0) == 0x80) return init & 0x0f;
+    std::size_t space = 1u << (init - 0xdd);
+    auto const s = static_cast<std::size_t>(read_int64_t<false>(space, bytes.c_ref()));
+    bytes->remove_prefix(space);
+    return s;
+  }
+
+  auto read_key(cxx::by_ref<cxx::json::byte_view> bytes) -> std::string_view
+  {
+    auto const first = static_cast<cxx::codec::numbyte>(bytes->front());
+    if (!is_string(first)) throw ::cxx::msgpack::unsupported("only string keys are supported");
+    bytes->remove_prefix(sizeof(first));
+    auto const key_size = string_size(first, cxx::by_ref(bytes));
+    if (std::size(bytes.c_ref()) < key_size)
+      throw cxx::msgpack::truncation_error("not enough data to decode json");
+    std::string_view key{reinterpret_cast<std::string_view::const_pointer>(bytes->data()),
+                         key_size};
+    bytes->remove_prefix(key_size);
+    return key;
+  }
+
   template <typename Sink>
   cxx::json::byte_view parse(quote<cxx::json::array>,
                              cxx::codec::numbyte const init,
@@ -179,20 +234,17 @@ namespace
                              Sink sink,
                              std::size_t level)
   {
-    std::size_t size = [init, &bytes]() -> std::size_t {
-      if ((init & 0xf0) == 0x90) return init & 0x0f;
-      std::size_t space = 1u << (init - 0xdb);
-      auto const s = static_cast<std::size_t>(read_int64_t<false>(space, bytes));
-      bytes.remove_prefix(space);
-      return s;
-    }();
-
+    auto size = array_size(init, cxx::by_ref(bytes));
     if (std::size(bytes) < size)
       throw cxx::msgpack::truncation_error("not enough data to decode json");
-    cxx::json::array array;
+    using json = typename Sink::json_type;
+    typename json::array array(sink.alloc);
     array.reserve(size);
     while (size--)
-    { bytes = parse(bytes, emplace_to<cxx::json::array>(cxx::by_ref(array)), level); }
+    {
+      bytes = parse(bytes, emplace_to<json, typename json::array>(cxx::by_ref(array), sink.alloc),
+                    level);
+    }
     sink(std::move(array));
     return bytes;
   }
@@ -204,29 +256,20 @@ namespace
                              Sink sink,
                              std::size_t level)
   {
-    std::size_t size = [init, &bytes]() -> std::size_t {
-      if ((init & 0xf0) == 0x80) return init & 0x0f;
-      std::size_t space = 1u << (init - 0xdd);
-      auto const s = static_cast<std::size_t>(read_int64_t<false>(space, bytes));
-      bytes.remove_prefix(space);
-      return s;
-    }();
-
-    cxx::json::dictionary dict;
+    auto size = dictionary_size(init, cxx::by_ref(bytes));
+    if (std::size(bytes) < 2 * size)
+      throw cxx::msgpack::truncation_error("not enough data to decode json");
+    using json = typename Sink::json_type;
+    typename json::dictionary dict(sink.alloc);
+    dict.reserve(size);
     while (size--)
     {
       if (std::size(bytes) < 2 * (size + 1))
         throw cxx::msgpack::truncation_error("not enough data to decode json");
-      auto const first = static_cast<cxx::codec::numbyte>(bytes.front());
-      if (!is_string(first)) throw ::cxx::msgpack::unsupported("only string keys are supported");
-      bytes.remove_prefix(sizeof(first));
-      auto const key_size = string_size(first, cxx::by_ref(bytes));
-      if (std::size(bytes) < key_size)
-        throw cxx::msgpack::truncation_error("not enough data to decode json");
-      std::string_view key{reinterpret_cast<std::string_view::const_pointer>(bytes.data()),
-                           key_size};
-      bytes.remove_prefix(key_size);
-      bytes = parse(bytes, emplace_to<cxx::json::dictionary>(cxx::by_ref(dict), key), level);
+      auto const key = read_key(cxx::by_ref(bytes));
+      bytes = parse(
+          bytes, emplace_to<json, typename json::dictionary>(cxx::by_ref(dict), sink.alloc, key),
+          level);
     }
     sink(std::move(dict));
     return bytes;
@@ -304,6 +347,184 @@ namespace
         throw cxx::msgpack::unsupported("decoding given type is not yet supported");
     }
   }
+  bool is_array(cxx::codec::numbyte const init)
+  {
+    return (init & 0xf0) == 0x90 || init == 0xdc || init == 0xdd;
+  }
+
+  bool is_dictionary(cxx::codec::numbyte const init)
+  {
+    return (init & 0xf0) == 0x80 || init == 0xde || init == 0xdf;
+  }
+
+  /*
+   * size of the initial byte and the value, length or count following it
+   */
+  std::size_t head_size(cxx::codec::numbyte const init) noexcept
+  {
+    switch (init)
+    {
+      case 0xc4:
+      case 0xc5:
+      case 0xc6:
+        return 1 + (1u << (init - 0xc4));
+      case 0xca:
+        return 1 + sizeof(float);
+      case 0xcb:
+        return 1 + sizeof(double);
+      case 0xcc:
+      case 0xcd:
+      case 0xce:
+      case 0xcf:
+        return 1 + (1u << (init - 0xcc));
+      case 0xd0:
+      case 0xd1:
+      case 0xd2:
+      case 0xd3:
+        return 1 + (1u << (init - 0xd0));
+      case 0xd9:
+      case 0xda:
+      case 0xdb:
+        return 1 + (1u << (init - 0xd9));
+      case 0xdc:
+      case 0xdd:
+        return 1 + (2u << (init - 0xdc));
+      case 0xde:
+      case 0xdf:
+        return 1 + (2u << (init - 0xde));
+      default:
+        return 1;
+    }
+  }
+
+  /*
+   * encoded size of the scalar, string or byte stream at the front of in
+   */
+  std::size_t extent(cxx::by_ref<::cxx::codec::segments> in)
+  {
+    auto const front = in->peek(0, 1);
+    if (std::empty(front)) throw cxx::msgpack::truncation_error("not enough data to decode json");
+    auto const init = static_cast<cxx::codec::numbyte>(front.front());
+    auto const size = head_size(init);
+    auto const bytes = init >= 0xc4 && init <= 0xc6;
+    if (!bytes && !is_string(init)) return size;
+    auto head = in->peek(0, size);
+    if (std::empty(head)) throw cxx::msgpack::truncation_error("not enough data to decode json");
+    head.remove_prefix(1);
+    if (bytes) return size + static_cast<std::size_t>(read_int64_t<false>(size - 1, head));
+    return size + string_size(init, cxx::by_ref(head));
+  }
+
+  /*
+   * decodes from a sequence of buffers, containers are walked here and every other item is
+   * parsed from a single view, copied together only if it straddles two buffers
+   */
+  template <typename Sink>
+  void gather(cxx::by_ref<::cxx::codec::segments> in, Sink sink, std::size_t level)
+  {
+    auto const front = in->peek(0, 1);
+    if (std::empty(front)) throw cxx::msgpack::truncation_error("not enough data to decode json");
+    auto const init = static_cast<cxx::codec::numbyte>(front.front());
+    auto const sequence = is_array(init);
+    if (!sequence && !is_dictionary(init))
+    {
+      auto const size = extent(cxx::by_ref(in));
+      auto const item = in->peek(0, size);
+      if (std::empty(item)) throw cxx::msgpack::truncation_error("not enough data to decode json");
+      parse(item, sink, level);
+      in->skip(size);
+      return;
+    }
+    if (level-- == 0) throw cxx::msgpack::unsupported("nesting level exceeds implementation limit");
+    auto head = in->peek(0, head_size(init));
+    if (std::empty(head)) throw cxx::msgpack::truncation_error("not enough data to decode json");
+    head.remove_prefix(1);
+    auto size = sequence ? array_size(init, cxx::by_ref(head))
+                         : dictionary_size(init, cxx::by_ref(head));
+    in->skip(head_size(init));
+    if (in->size() < (sequence ? size : 2 * size))
+      throw cxx::msgpack::truncation_error("not enough data to decode json");
+    using json = typename Sink::json_type;
+    if (sequence)
+    {
+      typename json::array array(sink.alloc);
+      array.reserve(size);
+      while (size--)
+        gather(cxx::by_ref(in),
+               emplace_to<json, typename json::array>(cxx::by_ref(array), sink.alloc), level);
+      sink(std::move(array));
+      return;
+    }
+    typename json::dictionary dict(sink.alloc);
+    dict.reserve(size);
+    while (size--)
+    {
+      auto const key_size = extent(cxx::by_ref(in));
+      auto data = in->peek(0, key_size);
+      if (std::empty(data)) throw cxx::msgpack::truncation_error("not enough data to decode json");
+      auto key = read_key(cxx::by_ref(data));
+      std::string stitched;
+      if (key_size > in->contiguous()) key = stitched.assign(key);
+      in->skip(key_size);
+      gather(cxx::by_ref(in),
+             emplace_to<json, typename json::dictionary>(cxx::by_ref(dict), sink.alloc, key),
+             level);
+    }
+    sink(std::move(dict));
+  }
+
+  /*
+   * encoded node found at the front of bytes
+   */
+  cxx::json::byte_view slice(cxx::by_ref<cxx::json::byte_view> bytes)
+  {
+    auto const first = bytes.c_ref();
+    cxx::detail::skipped node(std::allocator<char>{});
+    bytes = ::parse(first, emplace_to<cxx::detail::skip_json, cxx::detail::skipped>(
+                               cxx::by_ref(node), {}));
+    return first.substr(0, std::size(first) - std::size(bytes.c_ref()));
+  }
+
+  cxx::json decode_node(cxx::json::byte_view bytes)
+  {
+    return cxx::msgpack::decode(cxx::by_ref(bytes));
+  }
+
+  cxx::lazy::items split(cxx::json::byte_view bytes, cxx::lazy::format const& format)
+  {
+    if (std::empty(bytes)) throw cxx::msgpack::truncation_error("not enough data to decode json");
+    auto const init = static_cast<cxx::codec::numbyte>(bytes.front());
+    bytes.remove_prefix(sizeof(init));
+    if ((init & 0xf0) == 0x90 || init == 0xdc || init == 0xdd)
+    {
+      auto size = array_size(init, cxx::by_ref(bytes));
+      if (std::size(bytes) < size)
+        throw cxx::msgpack::truncation_error("not enough data to decode json");
+      cxx::lazy::array ret;
+      ret.reserve(size);
+      while (size--) ret.emplace_back(slice(cxx::by_ref(bytes)), format);
+      return ret;
+    }
+    if ((init & 0xf0) == 0x80 || init == 0xde || init == 0xdf)
+    {
+      auto size = dictionary_size(init, cxx::by_ref(bytes));
+      if (std::size(bytes) < 2 * size)
+        throw cxx::msgpack::truncation_error("not enough data to decode json");
+      cxx::lazy::dictionary ret;
+      ret.reserve(size);
+      while (size--)
+      {
+        if (std::size(bytes) < 2 * (size + 1))
+          throw cxx::msgpack::truncation_error("not enough data to decode json");
+        auto const key = read_key(cxx::by_ref(bytes));
+        ret.try_emplace(std::string(key), slice(cxx::by_ref(bytes)), format);
+      }
+      return ret;
+    }
+    return {};
+  }
+
+  cxx::lazy::format const lazy_format = {&decode_node, &split};
 } // namespace
 
 auto ::cxx::msgpack::decode(json::byte_stream const& stream) -> json
@@ -315,6 +536,103 @@ auto ::cxx::msgpack::decode(json::byte_stream const& stream) -> json
 auto ::cxx::msgpack::decode(by_ref<json::byte_view> bytes) -> json
 {
   cxx::json json;
-  bytes = parse(bytes.c_ref(), emplace_to<cxx::json>(cxx::by_ref(json)));
+  bytes = ::parse(bytes.c_ref(), emplace_to<cxx::json, cxx::json>(cxx::by_ref(json), {}));
+  return json;
+}
+
+auto ::cxx::msgpack::decode(std::vector<json::byte_view> const& segments) -> json
+{
+  ::cxx::codec::segments in(segments.data(), segments.data() + std::size(segments));
+  cxx::json json;
+  ::gather(cxx::by_ref(in), emplace_to<cxx::json, cxx::json>(cxx::by_ref(json), {}),
+           ::cxx::codec::max_nesting);
+  return json;
+}
+
+auto ::cxx::msgpack::decode(std::vector<iovec> const& segments) -> json
+{
+  std::vector<json::byte_view> views;
+  views.reserve(std::size(segments));
+  for (auto const& x : segments)
+    views.emplace_back(static_cast<cxx::byte const*>(x.iov_base), x.iov_len);
+  return decode(views);
+}
+
+auto ::cxx::msgpack::decode(json::byte_stream const& stream, std::pmr::memory_resource* resource)
+    -> pmr::json
+{
+  cxx::json::byte_view data(stream.data(), std::size(stream));
+  return decode(by_ref(data), resource);
+}
+
+auto ::cxx::msgpack::decode(by_ref<json::byte_view> bytes, std::pmr::memory_resource* resource)
+    -> pmr::json
+{
+  cxx::pmr::json json;
+  bytes = ::parse(bytes.c_ref(),
+                  emplace_to<cxx::pmr::json, cxx::pmr::json>(cxx::by_ref(json), resource));
+  return json;
+}
+
+auto ::cxx::msgpack::decode(json::byte_stream const& stream, cxx::arena& arena) -> pmr::json&
+{
+  cxx::json::byte_view data(stream.data(), std::size(stream));
+  return decode(by_ref(data), arena);
+}
+
+auto ::cxx::msgpack::decode(by_ref<json::byte_view> bytes, cxx::arena& arena) -> pmr::json&
+{
+  return arena.construct<cxx::pmr::json>(decode(by_ref(bytes), &arena));
+}
+
+auto ::cxx::msgpack::decode_tape(json::byte_stream const& stream) -> tape
+{
+  cxx::json::byte_view data(stream.data(), std::size(stream));
+  return decode_tape(by_ref(data));
+}
+
+auto ::cxx::msgpack::decode_tape(by_ref<json::byte_view> bytes) -> tape
+{
+  cxx::tape doc;
+  cxx::tape::builder out{cxx::by_ref(doc)};
+  out.reserve(std::size(bytes.c_ref()));
+  bytes = ::parse(bytes.c_ref(),
+                  emplace_to<cxx::detail::tape_json, cxx::tape>(cxx::by_ref(doc), &out));
+  return doc;
+}
+
+auto ::cxx::msgpack::decode_view(json::byte_stream const& stream) -> json_view
+{
+  cxx::json::byte_view data(stream.data(), std::size(stream));
+  return decode_view(by_ref(data));
+}
+
+auto ::cxx::msgpack::decode_view(by_ref<json::byte_view> bytes) -> json_view
+{
+  cxx::json_view json;
+  bytes = ::parse(bytes.c_ref(),
+                  emplace_to<cxx::json_view, cxx::json_view>(cxx::by_ref(json), {}));
   return json;
 }
+
+auto ::cxx::msgpack::decode_lazy(json::byte_stream const& stream) -> lazy
+{
+  return lazy(cxx::json::byte_view(stream.data(), std::size(stream)), lazy_format);
+}
+
+auto ::cxx::msgpack::decode_lazy(by_ref<json::byte_view> bytes) -> lazy
+{
+  return lazy(slice(by_ref(bytes)), lazy_format);
+}
+
+void ::cxx::msgpack::decode_into(json::byte_stream const& stream, by_ref<json> target)
+{
+  cxx::json::byte_view data(stream.data(), std::size(stream));
+  decode_into(by_ref(data), by_ref(target));
+}
+
+void ::cxx::msgpack::decode_into(by_ref<json::byte_view> bytes, by_ref<json> target)
+{
+  bytes = ::parse(bytes.c_ref(),
+                  emplace_to<cxx::detail::reuse_json, cxx::json>(cxx::by_ref(target), nullptr));
+}
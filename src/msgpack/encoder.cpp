@@ -22,144 +22,249 @@ namespace
       constexpr static std::int64_t const min_initial = -0x20;
     };
 
-    auto const insert = [](auto x, cxx::by_ref<cxx::json::byte_stream> stream) -> decltype(auto) {
-      using T = std::decay_t<decltype(x)>;
-      auto it = stream->insert(stream->end(), sizeof(T), {});
-      ::cxx::codec::write_to(::cxx::codec::hton(static_cast<T>(x)), std::addressof(*it));
-      return *(--it);
-    };
+    template <template <typename> typename Allocator>
+    std::size_t size_of(cxx::basic_json<Allocator> const&) noexcept;
+
+    constexpr std::size_t size_of(std::int64_t x) noexcept
+    {
+      if (x >= consts::min_initial && x <= consts::max_initial) return 1;
+      auto const n = static_cast<std::uint64_t>(x);
+      return 1 + ::cxx::codec::space((x < 0) ? (~n + 1) : n);
+    }
 
-    auto const collect =
-        [](auto const& x, cxx::by_ref<cxx::json::byte_stream> stream, auto code, auto sink)
+    template <typename T, typename Allocator>
+    std::size_t size_of(std::vector<T, Allocator> const& x) noexcept
+    {
+      auto ret = 1 + sizeof(std::uint32_t);
+      if constexpr (std::is_same_v<T, cxx::byte>)
+        ret += std::size(x);
+      else
+        for (auto const& item : x) ret += size_of(item);
+      return ret;
+    }
 
+    template <typename Allocator>
+    std::size_t size_of(
+        std::basic_string<char, std::char_traits<char>, Allocator> const& x) noexcept
     {
-      auto const size = std::size(x);
-      using value_type = typename std::decay_t<decltype(x)>::value_type;
-      ::cxx::codec::assure(cxx::by_ref(stream),
-                           size * sizeof(value_type) + sizeof(std::uint32_t) + 1);
+      return 1 + sizeof(std::uint32_t) + std::size(x);
+    }
+
+    template <typename Key, typename T, typename Compare, typename Allocator>
+    std::size_t size_of(cxx::flat_map<Key, T, Compare, Allocator> const& x) noexcept
+    {
+      auto ret = 1 + sizeof(std::uint32_t);
+      for (auto const& [key, value] : x) ret += size_of(key) + size_of(value);
+      return ret;
+    }
+
+    constexpr std::size_t size_of(double) noexcept { return sizeof(double) + 1; }
+    constexpr std::size_t size_of(bool) noexcept { return 1; }
+    constexpr std::size_t size_of(cxx::json::null_t) noexcept { return 1; }
+
+    template <template <typename> typename Allocator>
+    [[gnu::noinline]] std::size_t size_of(cxx::basic_json<Allocator> const& json) noexcept
+    {
+      return cxx::visit([](auto const& x) { return detail::size_of(x); }, json);
+    }
 
-      stream->emplace_back(cxx::byte(code));
-      insert(static_cast<std::uint32_t>(size), cxx::by_ref(stream));
-      sink(x, cxx::by_ref(stream));
+    auto const put = [](auto x, cxx::byte* it) {
+      ::cxx::codec::write_to(::cxx::codec::hton(x), it);
+      return it + sizeof(x);
     };
 
-    void encode(cxx::json const&, cxx::by_ref<cxx::json::byte_stream>);
+    auto const header = [](cxx::byte* it, consts::type code, std::size_t size) {
+      *it = cxx::byte(code);
+      return put(static_cast<std::uint32_t>(size), it + 1);
+    };
+
+    using writer = cxx::by_ref<::cxx::codec::writer>;
 
-    [[gnu::flatten]] cxx::byte& assign(std::int64_t const x,
-                                       cxx::by_ref<cxx::json::byte_stream> stream)
+    template <template <typename> typename Allocator>
+    void encode(cxx::basic_json<Allocator> const&, writer);
+
+    [[gnu::flatten]] void encode(std::int64_t x, writer out)
     {
+      auto* it = out->reserve(size_of(x));
+      if (x >= consts::min_initial && x <= consts::max_initial)
+      {
+        *it = cxx::byte((x < 0) ? ((0xff & x) | consts::negative_initial) : (0xff & x));
+        return out->commit(it + 1);
+      }
       auto const n = static_cast<std::uint64_t>(x);
       auto const code = ::cxx::codec::code((x < 0) ? (~n + 1) : n);
-      auto const space = 1u << code;
-      ::cxx::codec::assure(cxx::by_ref(stream), sizeof(cxx::byte) + space);
-      stream->emplace_back(cxx::byte(code + ((x < 0) ? consts::negative : consts::positive)));
+      *it++ = cxx::byte(code + ((x < 0) ? consts::negative : consts::positive));
 
       /// space optimization - adjust number of bytes needed to store a value
       /// is it really needed? use 8-bytes allways instead
-      switch (space)
+      switch (code)
       {
-        case sizeof(std::uint8_t):
-          return insert(static_cast<std::uint8_t>(x), cxx::by_ref(stream));
-        case sizeof(std::uint16_t):
-          return insert(static_cast<std::uint16_t>(x), cxx::by_ref(stream));
-        case sizeof(std::uint32_t):
-          return insert(static_cast<std::uint32_t>(x), cxx::by_ref(stream));
+        case 0:
+          return out->commit(put(static_cast<std::uint8_t>(x), it));
+        case 1:
+          return out->commit(put(static_cast<std::uint16_t>(x), it));
+        case 2:
+          return out->commit(put(static_cast<std::uint32_t>(x), it));
         default:
-          return insert(static_cast<std::uint64_t>(x), cxx::by_ref(stream));
+          return out->commit(put(static_cast<std::uint64_t>(x), it));
       }
     }
 
-    [[gnu::flatten]] cxx::byte& encode(std::int64_t x, cxx::by_ref<cxx::json::byte_stream> stream)
+    [[gnu::flatten]] void encode(consts::type code, writer out)
     {
-      auto const initial_byte = [&x, &stream] {
-        if (x < consts::min_initial || x > consts::max_initial) return false;
-        stream->emplace_back(
-            cxx::byte((x < 0) ? ((0xff & x) | consts::negative_initial) : (0xff & x)));
-        return true;
-      };
-      if (initial_byte()) return stream->back();
-      return assign(x, cxx::by_ref(stream));
+      auto* it = out->reserve(1);
+      *it = cxx::byte(code);
+      out->commit(it + 1);
     }
 
-    [[gnu::flatten]] void encode(cxx::json::null_t, cxx::by_ref<cxx::json::byte_stream> stream)
+    [[gnu::flatten]] void encode(cxx::json::null_t, writer out)
     {
-      stream->push_back(cxx::byte(consts::null));
+      encode(consts::null, cxx::by_ref(out));
     }
 
-    [[gnu::flatten]] void encode(bool b, cxx::by_ref<cxx::json::byte_stream> stream)
+    [[gnu::flatten]] void encode(bool b, writer out)
     {
-      stream->push_back(cxx::byte(b ? consts::True : consts::False));
+      encode(b ? consts::True : consts::False, cxx::by_ref(out));
     }
 
-    [[gnu::flatten]] void encode(std::string const& x, cxx::by_ref<cxx::json::byte_stream> stream)
+    [[gnu::flatten]] void encode(cxx::byte const* first, std::size_t size, consts::type code,
+                                 writer out)
     {
-      auto const sink = [](auto const& y, cxx::by_ref<cxx::json::byte_stream> out)
-
-      {
-        auto const first = reinterpret_cast<cxx::byte const*>(y.data());
-        out->insert(out->end(), first, first + std::size(y));
-      };
-      collect(x, cxx::by_ref(stream), consts::string, sink);
+      out->commit(header(out->reserve(1 + sizeof(std::uint32_t)), code, size));
+      out->append(first, size);
     }
 
-    [[gnu::flatten]] void encode(cxx::json::byte_stream const& x,
-                                 cxx::by_ref<cxx::json::byte_stream> stream)
+    template <typename Allocator>
+    [[gnu::flatten]] void encode(
+        std::basic_string<char, std::char_traits<char>, Allocator> const& x, writer out)
     {
-      auto const sink = [](auto const& y, cxx::by_ref<cxx::json::byte_stream> out)
-
-      {
-        auto const first = y.data();
-        out->insert(out->end(), first, first + std::size(y));
-      };
-      collect(x, cxx::by_ref(stream), consts::bin, sink);
+      encode(reinterpret_cast<cxx::byte const*>(x.data()), std::size(x), consts::string,
+             cxx::by_ref(out));
     }
 
-    [[gnu::flatten]] void encode(cxx::json::array const& x,
-                                 cxx::by_ref<cxx::json::byte_stream> stream)
+    template <typename Allocator>
+    [[gnu::flatten]] void encode(std::vector<cxx::byte, Allocator> const& x, writer out)
     {
-      auto const sink = [](auto const& y, cxx::by_ref<cxx::json::byte_stream> out)
-
-      {
-        for (auto const& value : y) encode(value, cxx::by_ref(out));
-      };
-      collect(x, cxx::by_ref(stream), consts::array, sink);
+      encode(x.data(), std::size(x), consts::bin, cxx::by_ref(out));
     }
 
-    [[gnu::flatten]] void encode(cxx::json::dictionary const& x,
-                                 cxx::by_ref<cxx::json::byte_stream> stream)
+    template <template <typename> typename Allocator>
+    [[gnu::flatten]] void encode(std::vector<cxx::basic_json<Allocator>,
+                                             Allocator<cxx::basic_json<Allocator>>> const& x,
+                                 writer out)
     {
-      auto const sink = [](auto const& y, cxx::by_ref<cxx::json::byte_stream> out)
+      out->commit(header(out->reserve(1 + sizeof(std::uint32_t)), consts::array, std::size(x)));
+      for (auto const& value : x) encode(value, cxx::by_ref(out));
+    }
 
+    template <typename Key, typename T, typename Compare, typename Allocator>
+    [[gnu::flatten]] void encode(cxx::flat_map<Key, T, Compare, Allocator> const& x, writer out)
+    {
+      out->commit(
+          header(out->reserve(1 + sizeof(std::uint32_t)), consts::dictionary, std::size(x)));
+      for (auto const& [key, value] : x)
       {
-        for (auto const& [key, value] : y)
-        {
-          encode(key, cxx::by_ref(out));
-          encode(value, cxx::by_ref(out));
-        }
-      };
-      collect(x, cxx::by_ref(stream), consts::dictionary, sink);
+        encode(key, cxx::by_ref(out));
+        encode(value, cxx::by_ref(out));
+      }
     }
 
-    [[gnu::flatten]] void encode(double x, cxx::by_ref<cxx::json::byte_stream> stream)
+    [[gnu::flatten]] void encode(double x, writer out)
     {
-      ::cxx::codec::assure(cxx::by_ref(stream), sizeof(double) + 1);
-      x = ::cxx::codec::hton(x);
-      auto const* first = static_cast<cxx::byte const*>(static_cast<void const*>(&x));
-      stream->emplace_back(cxx::byte(consts::floating));
-      stream->insert(stream->end(), first, first + sizeof(double));
+      auto* it = out->reserve(sizeof(double) + 1);
+      *it = cxx::byte(consts::floating);
+      out->commit(put(x, it + 1));
     }
 
-    [[gnu::noinline, gnu::flatten]] void encode(cxx::json const& json,
-                                                cxx::by_ref<cxx::json::byte_stream> stream)
+    template <template <typename> typename Allocator>
+    [[gnu::noinline, gnu::flatten]] void encode(cxx::basic_json<Allocator> const& json, writer out)
     {
-      cxx::visit([&stream](auto const& x) { detail::encode(x, cxx::by_ref(stream)); }, json);
+      cxx::visit([&out](auto const& x) { detail::encode(x, cxx::by_ref(out)); }, json);
     }
   } // namespace detail
 } // namespace
 
 auto ::cxx::msgpack::encode(json const& obj) -> json::byte_stream
 {
-  auto stream = ::cxx::codec::reserved<json::byte_stream>(sizeof(json));
-  detail::encode(obj, cxx::by_ref(stream));
+  json::byte_stream stream;
+  encode_into(obj, cxx::by_ref(stream));
   return stream;
 }
+
+template <template <typename> typename Allocator>
+auto ::cxx::msgpack::encode(basic_json<Allocator> const& obj) -> json::byte_stream
+{
+  json::byte_stream stream;
+  encode_into(obj, cxx::by_ref(stream));
+  return stream;
+}
+
+void ::cxx::msgpack::encode_into(json const& obj, cxx::by_ref<json::byte_stream> out)
+{
+  ::cxx::codec::writer writer{cxx::by_ref(out)};
+  detail::encode(obj, cxx::by_ref(writer));
+  writer.flush();
+}
+
+template <template <typename> typename Allocator>
+void ::cxx::msgpack::encode_into(basic_json<Allocator> const& obj,
+                                 cxx::by_ref<json::byte_stream> out)
+{
+  ::cxx::codec::writer writer{cxx::by_ref(out)};
+  detail::encode(obj, cxx::by_ref(writer));
+  writer.flush();
+}
+
+void ::cxx::msgpack::encode_into(json const& obj, cxx::by_ref<byte_chain> out)
+{
+  ::cxx::codec::writer writer{cxx::by_ref(out)};
+  detail::encode(obj, cxx::by_ref(writer));
+  writer.flush();
+}
+
+template <template <typename> typename Allocator>
+void ::cxx::msgpack::encode_into(basic_json<Allocator> const& obj, cxx::by_ref<byte_chain> out)
+{
+  ::cxx::codec::writer writer{cxx::by_ref(out)};
+  detail::encode(obj, cxx::by_ref(writer));
+  writer.flush();
+}
+
+auto ::cxx::msgpack::encoded_size(json const& obj) noexcept -> std::size_t
+{
+  return detail::size_of(obj);
+}
+
+template <template <typename> typename Allocator>
+auto ::cxx::msgpack::encoded_size(basic_json<Allocator> const& obj) noexcept -> std::size_t
+{
+  return detail::size_of(obj);
+}
+
+auto ::cxx::msgpack::encode_to(json const& obj, cxx::byte* out, std::size_t size) noexcept
+    -> std::optional<std::size_t>
+{
+  auto const needed = encoded_size(obj);
+  if (needed > size) return std::nullopt;
+  ::cxx::codec::writer writer(out, size);
+  detail::encode(obj, cxx::by_ref(writer));
+  return needed;
+}
+
+template <template <typename> typename Allocator>
+auto ::cxx::msgpack::encode_to(basic_json<Allocator> const& obj, cxx::byte* out,
+                               std::size_t size) noexcept -> std::optional<std::size_t>
+{
+  auto const needed = encoded_size(obj);
+  if (needed > size) return std::nullopt;
+  ::cxx::codec::writer writer(out, size);
+  detail::encode(obj, cxx::by_ref(writer));
+  return needed;
+}
+
+template auto ::cxx::msgpack::encode(pmr::json const&) -> json::byte_stream;
+template void ::cxx::msgpack::encode_into(pmr::json const&, cxx::by_ref<json::byte_stream>);
+template void ::cxx::msgpack::encode_into(pmr::json const&, cxx::by_ref<byte_chain>);
+template auto ::cxx::msgpack::encoded_size(pmr::json const&) noexcept -> std::size_t;
+template auto ::cxx::msgpack::encode_to(pmr::json const&, cxx::byte*, std::size_t) noexcept
+    -> std::optional<std::size_t>;
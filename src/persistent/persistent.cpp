@@ -0,0 +1,137 @@
+#include "inc/cxx/persistent.hpp"
+
+namespace
+{
+  template <typename T, typename = void>
+  struct has_size : std::false_type {
+  };
+
+  template <typename T>
+  struct has_size<
+      T,
+      std::void_t<decltype(std::declval<std::size_t&>() = (std::declval<T const&>().size()))>>
+      : std::true_type {
+  };
+
+  template <typename T>
+  auto make(T&& x)
+  {
+    using object = cxx::persistent::object;
+    return std::make_shared<object const>(std::in_place_type<std::decay_t<T>>, std::forward<T>(x));
+  }
+
+  auto const from_json = cxx::overload{
+      [](cxx::json::dictionary const& x) -> cxx::persistent {
+        cxx::persistent::dictionary ret;
+        ret.reserve(std::size(x));
+        for (auto const& [key, value] : x) ret.emplace_hint(std::end(ret), key, value);
+        return ret;
+      },
+      [](cxx::json::array const& x) -> cxx::persistent {
+        return cxx::persistent::array(std::begin(x), std::end(x));
+      },
+      [](auto const& x) -> cxx::persistent { return x; }};
+
+  auto const to_json = cxx::overload{
+      [](cxx::persistent::dictionary const& x) -> cxx::json {
+        cxx::json::dictionary ret;
+        ret.reserve(std::size(x));
+        for (auto const& [key, value] : x) ret.emplace_hint(std::end(ret), key, value.to_json());
+        return ret;
+      },
+      [](cxx::persistent::array const& x) -> cxx::json {
+        cxx::json::array ret;
+        ret.reserve(std::size(x));
+        for (auto const& value : x) ret.push_back(value.to_json());
+        return ret;
+      },
+      [](auto const& x) -> cxx::json { return x; }};
+} // namespace
+
+::cxx::persistent::persistent(bool x) : node(make(x)) {}
+
+::cxx::persistent::persistent(double x) : node(make(x)) {}
+
+::cxx::persistent::persistent(std::string x) : node(make(std::move(x))) {}
+
+::cxx::persistent::persistent(byte_stream x) : node(make(std::move(x))) {}
+
+::cxx::persistent::persistent(dictionary x) : node(make(std::move(x))) {}
+
+::cxx::persistent::persistent(array x) : node(make(std::move(x))) {}
+
+::cxx::persistent::persistent(json const& x) : persistent(cxx::visit(from_json, x)) {}
+
+auto ::cxx::persistent::to_object() const noexcept -> object const&
+{
+  static object const null_object = null;
+  return node ? *node : null_object;
+}
+
+auto ::cxx::persistent::operator[](std::string const& k) const -> persistent const&
+{
+  return cxx::get<dictionary>(*this).at(std::string_view(k));
+}
+
+auto ::cxx::persistent::operator[](std::size_t k) const -> persistent const&
+{
+  return cxx::get<array>(*this).at(k);
+}
+
+auto ::cxx::persistent::with(std::string const& key, persistent value) const -> persistent
+{
+  auto dict = cxx::get<dictionary>(*this);
+  dict[key] = std::move(value);
+  return dict;
+}
+
+auto ::cxx::persistent::with(std::size_t k, persistent value) const -> persistent
+{
+  auto items = cxx::get<array>(*this);
+  items.at(k) = std::move(value);
+  return items;
+}
+
+auto ::cxx::persistent::with_appended(persistent value) const -> persistent
+{
+  auto const& orig = cxx::get<array>(*this);
+  array items;
+  items.reserve(std::size(orig) + 1);
+  items.insert(std::end(items), std::begin(orig), std::end(orig));
+  items.push_back(std::move(value));
+  return items;
+}
+
+auto ::cxx::persistent::without(std::string const& key) const -> persistent
+{
+  auto dict = cxx::get<dictionary>(*this);
+  dict.erase(key);
+  return dict;
+}
+
+auto ::cxx::persistent::to_json() const -> json
+{
+  return cxx::visit(::to_json, *this);
+}
+
+[[gnu::flatten]] auto ::cxx::persistent::size() const noexcept -> std::size_t
+{
+  auto const func = cxx::overload{[](null_t) -> std::size_t { return 0; },
+                                  [](auto const& x) -> std::size_t {
+                                    if constexpr (has_size<decltype(x)>::value)
+                                      return std::size(x);
+                                    else
+                                      return 1;
+                                  }};
+  return cxx::visit(func, *this);
+}
+
+[[gnu::flatten]] bool ::cxx::persistent::empty() const noexcept
+{
+  return size() == 0;
+}
+
+bool ::cxx::operator==(persistent const& lhs, persistent const& rhs) noexcept
+{
+  return lhs.node == rhs.node || lhs.to_object() == rhs.to_object();
+}
@@ -0,0 +1,82 @@
+#include "inc/cxx/pool.hpp"
+#include <new>
+
+namespace
+{
+  constexpr std::size_t const alignment = alignof(std::max_align_t);
+
+  /*
+   * index of the smallest power of two holding bytes, counted from 16
+   */
+  std::size_t bin_of(std::size_t bytes) noexcept
+  {
+    if (bytes <= 16) return 0;
+    return static_cast<std::size_t>(64 - __builtin_clzll(bytes - 1) - 4);
+  }
+} // namespace
+
+::cxx::pool::pool(std::size_t cached, std::pmr::memory_resource* resource)
+    : max_cached(cached), upstream(resource)
+{
+}
+
+::cxx::pool::~pool()
+{
+  release();
+}
+
+auto ::cxx::pool::local() -> pool&
+{
+  thread_local pool instance;
+  return instance;
+}
+
+void ::cxx::pool::release() noexcept
+{
+  auto size = min_block_size;
+  for (auto& x : bins)
+  {
+    while (auto* head = x.head)
+    {
+      x.head = head->next;
+      upstream->deallocate(head, size, alignment);
+    }
+    x.cached = 0;
+    size *= 2;
+  }
+}
+
+void* ::cxx::pool::do_allocate(std::size_t bytes, std::size_t align)
+{
+  if (bytes > max_block_size || align > alignment)
+  {
+    ++missed;
+    return upstream->allocate(bytes, align);
+  }
+  auto const index = bin_of(bytes);
+  auto& x = bins[index];
+  if (auto* head = x.head)
+  {
+    ++served;
+    x.head = head->next;
+    --x.cached;
+    return head;
+  }
+  ++missed;
+  return upstream->allocate(min_block_size << index, alignment);
+}
+
+void ::cxx::pool::do_deallocate(void* ptr, std::size_t bytes, std::size_t align)
+{
+  if (bytes > max_block_size || align > alignment) return upstream->deallocate(ptr, bytes, align);
+  auto const index = bin_of(bytes);
+  auto& x = bins[index];
+  if (x.cached == max_cached) return upstream->deallocate(ptr, min_block_size << index, alignment);
+  x.head = ::new (ptr) node{x.head};
+  ++x.cached;
+}
+
+bool ::cxx::pool::do_is_equal(std::pmr::memory_resource const& other) const noexcept
+{
+  return this == &other;
+}
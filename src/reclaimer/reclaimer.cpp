@@ -0,0 +1,60 @@
+#include "inc/cxx/reclaimer.hpp"
+#include <algorithm>
+
+::cxx::reclaimer::reclaimer(std::size_t size) : capacity(std::max<std::size_t>(size, 1))
+{
+  queue.reserve(capacity);
+  worker = std::thread([this] { run(); });
+}
+
+::cxx::reclaimer::~reclaimer()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  queued.notify_one();
+  worker.join();
+}
+
+void ::cxx::reclaimer::defer(json&& x)
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  freed.wait(lock, [this] { return std::size(queue) < capacity; });
+  queue.push_back(std::move(x));
+  x = json::null;
+  lock.unlock();
+  queued.notify_one();
+}
+
+void ::cxx::reclaimer::drain()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  freed.wait(lock, [this] { return std::empty(queue) && in_flight == 0; });
+}
+
+void ::cxx::reclaimer::run()
+{
+  std::vector<json> batch;
+  batch.reserve(capacity);
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true)
+  {
+    queued.wait(lock, [this] { return stopping || !std::empty(queue); });
+    if (std::empty(queue)) return;
+    queue.swap(batch);
+    in_flight = std::size(batch);
+    lock.unlock();
+    freed.notify_all();
+    batch.clear();
+    lock.lock();
+    in_flight = 0;
+    freed.notify_all();
+  }
+}
+
+void ::cxx::defer_destroy(json&& x)
+{
+  static reclaimer instance;
+  instance.defer(std::move(x));
+}
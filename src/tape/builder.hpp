@@ -0,0 +1,140 @@
+#pragma once
+#include "inc/cxx/tape.hpp"
+#include "inc/cxx/by_ref.hpp"
+#include "src/codec.hpp"
+#include <list>
+
+/*
+ * appends nodes to a tape in decoding order, containers are opened before their items
+ * and closed once the last item is written
+ */
+class cxx::tape::builder
+{
+public:
+  explicit builder(cxx::by_ref<tape> t) noexcept : doc(t.get()) {}
+
+  /*
+   * no document of this size needs more text, words are a guess
+   */
+  void reserve(std::size_t bytes)
+  {
+    doc.tags.reserve(bytes / 2 + 2);
+    doc.text.reserve(bytes);
+  }
+
+  std::size_t open(kind k)
+  {
+    auto const at = std::size(doc.tags);
+    doc.tags.push_back(builder::tag(k));
+    doc.tags.push_back(0);
+    return at;
+  }
+
+  void close(std::size_t at, std::size_t count) noexcept
+  {
+    doc.tags[at] |= std::size(doc.tags);
+    doc.tags[at + 1] = count;
+  }
+
+  void append(std::int64_t x)
+  {
+    doc.tags.push_back(builder::tag(kind::integer));
+    doc.tags.push_back(static_cast<word>(x));
+  }
+
+  void append(double x)
+  {
+    word bits;
+    static_assert(sizeof(bits) == sizeof(x));
+    std::memcpy(&bits, &x, sizeof(bits));
+    doc.tags.push_back(builder::tag(kind::real));
+    doc.tags.push_back(bits);
+  }
+
+  void append(bool x) { doc.tags.push_back(builder::tag(kind::boolean) | (x ? 1 : 0)); }
+  void append(null_t) { doc.tags.push_back(builder::tag(kind::null)); }
+  void append(std::string_view x) { text(kind::string, x.data(), std::size(x)); }
+  void append(std::string const& x) { append(std::string_view(x)); }
+
+  void append(byte_view x)
+  {
+    text(kind::bytes, reinterpret_cast<char const*>(x.data()), std::size(x));
+  }
+
+  void append(std::list<byte_view> const& chunks, std::size_t length)
+  {
+    doc.tags.push_back(builder::tag(kind::bytes) | std::size(doc.text));
+    doc.tags.push_back(length);
+    for (auto const& x : chunks)
+      doc.text.append(reinterpret_cast<char const*>(x.data()), std::size(x));
+  }
+
+private:
+  static word tag(kind k) noexcept { return static_cast<word>(k) << shift; }
+
+  void text(kind k, char const* data, std::size_t size)
+  {
+    doc.tags.push_back(builder::tag(k) | std::size(doc.text));
+    doc.tags.push_back(size);
+    doc.text.append(data, size);
+  }
+
+  tape& doc;
+};
+
+namespace cxx::detail
+{
+  /*
+   * stands in for a container while its items are written to the tape
+   */
+  template <tape::kind K>
+  struct tape_frame {
+    using size_type = std::size_t;
+
+    explicit tape_frame(tape::builder* b) : out(b), at(b->open(K)) {}
+    size_type size() const noexcept { return count; }
+    void reserve(size_type) const noexcept {}
+
+    tape::builder* out;
+    std::size_t at;
+    std::size_t count = 0;
+  };
+
+  /*
+   * node type seen by the decoders when they write a tape
+   */
+  struct tape_json {
+    using allocator = tape::builder*;
+    using string = std::string;
+    using array = tape_frame<tape::kind::array>;
+    using dictionary = tape_frame<tape::kind::dictionary>;
+  };
+
+  /*
+   * dictionary keys are written as soon as the sink for their value is created
+   */
+  template <typename T>
+  auto tape_sink(cxx::by_ref<T> target, tape::builder* out, std::string_view key)
+  {
+    if constexpr (std::is_same_v<T, tape_json::dictionary>) out->append(key);
+    auto const counted = [ref = cxx::by_ref(target)] {
+      if constexpr (!std::is_same_v<T, tape>) ++ref->count;
+    };
+    auto const impl = [out, counted](auto&& x) {
+      using type = std::decay_t<decltype(x)>;
+      if constexpr (std::is_same_v<type, tape_json::array> ||
+                    std::is_same_v<type, tape_json::dictionary>)
+        out->close(x.at, x.count);
+      else
+        out->append(x);
+      counted();
+    };
+    auto const adapter = cxx::overload{
+        [out, counted](std::list<tape::byte_view> const& chunks, std::size_t length) {
+          out->append(chunks, length);
+          counted();
+        },
+        impl};
+    return ::cxx::codec::sink<tape_json, std::decay_t<decltype(adapter)>>{adapter, out};
+  }
+} // namespace cxx::detail
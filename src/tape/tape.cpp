@@ -0,0 +1,59 @@
+#include "inc/cxx/tape.hpp"
+#include <stdexcept>
+
+auto ::cxx::tape::value::size() const noexcept -> std::size_t
+{
+  switch (type())
+  {
+    case kind::dictionary:
+    case kind::array:
+    case kind::string:
+    case kind::bytes:
+      return second();
+    case kind::null:
+      return 0;
+    default:
+      return 1;
+  }
+}
+
+auto ::cxx::tape::value::operator[](std::string_view key) const -> value
+{
+  return get<tape::dictionary>()[key];
+}
+
+auto ::cxx::tape::value::operator[](std::size_t n) const -> value
+{
+  return get<tape::array>()[n];
+}
+
+auto ::cxx::tape::array::operator[](std::size_t n) const -> tape::value
+{
+  if (n >= size()) throw std::out_of_range("cxx::tape::array");
+  auto it = begin();
+  while (n--) ++it;
+  return *it;
+}
+
+auto ::cxx::tape::dictionary::find(std::string_view key) const noexcept -> iterator
+{
+  auto const* const words = self.doc->tags.data();
+  auto const* const text = self.doc->text.data();
+  auto const last = self.skip();
+  auto index = self.index + 2;
+  while (index != last)
+  {
+    if (words[index + 1] == std::size(key) &&
+        std::string_view(text + payload_of(words[index]), std::size(key)) == key)
+      break;
+    index = tape::value(self.doc, index + 2).skip();
+  }
+  return iterator(self.doc, index);
+}
+
+auto ::cxx::tape::dictionary::operator[](std::string_view key) const -> tape::value
+{
+  auto const it = find(key);
+  if (it == end()) throw std::out_of_range("cxx::tape::dictionary");
+  return (*it).second;
+}
@@ -0,0 +1,79 @@
+#include "inc/cxx/arena.hpp"
+#include "inc/cxx/cbor.hpp"
+#include "inc/cxx/msgpack.hpp"
+#include "test/catch.hpp"
+#include <cstdint>
+
+using namespace cxx::literals;
+
+namespace
+{
+  auto const aligned = [](void const* ptr, std::size_t alignment) {
+    return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+  };
+
+  cxx::json const document = {
+      "lorem"_key >> cxx::json{1, -2.5, "ipsum dolor sit amet, consectetur adipiscing elit",
+                               cxx::json::null, true},
+      "sed"_key >> cxx::json{"do"_key >> cxx::json::byte_stream{cxx::byte{0x2a}},
+                             "eiusmod tempor incididunt ut labore"_key >> "et dolore magna"}};
+
+  template <typename Codec>
+  void decodes_into(cxx::arena& arena)
+  {
+    auto const bytes = Codec::encode(document);
+    for (int i = 0; i < 3; ++i)
+    {
+      arena.reset();
+      auto const& json = Codec::decode(bytes, arena);
+      REQUIRE(Codec::encode(json) == bytes);
+      REQUIRE(cxx::get<cxx::pmr::json::dictionary>(json).get_allocator().resource() == &arena);
+      REQUIRE(cxx::get<cxx::pmr::json::string>(json["lorem"][2]).get_allocator().resource() ==
+              &arena);
+      REQUIRE(arena.used() > 0);
+    }
+  }
+} // namespace
+
+TEST_CASE("cxx::arena hands out aligned memory")
+{
+  cxx::arena arena(1024);
+  for (std::size_t alignment : {1u, 2u, 8u, 16u, 64u, 1u, 4u})
+  {
+    auto* ptr = arena.allocate(alignment * 3, alignment);
+    REQUIRE(aligned(ptr, alignment));
+  }
+  REQUIRE(arena.capacity() == 1024);
+  SECTION("allocations larger than a block get their own block")
+  {
+    auto* ptr = arena.allocate(4000, 32);
+    REQUIRE(aligned(ptr, 32));
+    REQUIRE(arena.capacity() >= 5024);
+  }
+}
+
+TEST_CASE("cxx::arena reuses its blocks after reset")
+{
+  cxx::arena arena(128);
+  for (int i = 0; i < 100; ++i) REQUIRE(arena.allocate(24, 8) != nullptr);
+  auto const capacity = arena.capacity();
+  REQUIRE(arena.used() >= 2400);
+  arena.reset();
+  REQUIRE(arena.used() == 0);
+  for (int i = 0; i < 100; ++i) REQUIRE(arena.allocate(24, 8) != nullptr);
+  REQUIRE(arena.capacity() == capacity);
+  REQUIRE(arena.is_equal(arena));
+  REQUIRE_FALSE(arena.is_equal(*std::pmr::new_delete_resource()));
+}
+
+TEST_CASE("cbor can decode into an arena")
+{
+  cxx::arena arena(64);
+  decodes_into<cxx::cbor>(arena);
+}
+
+TEST_CASE("msgpack can decode into an arena")
+{
+  cxx::arena arena(64);
+  decodes_into<cxx::msgpack>(arena);
+}
@@ -0,0 +1,107 @@
+#include "inc/cxx/cbor.hpp"
+#include "inc/cxx/msgpack.hpp"
+#include "test/catch.hpp"
+#include <cstdio>
+#include <unistd.h>
+
+using namespace cxx::literals;
+
+namespace
+{
+  cxx::json const document = {
+      "lorem"_key >> cxx::json{1, -100, 70000, -2.5, "ipsum", cxx::json::null, true},
+      "dolor"_key >> cxx::json{"sit"_key >> cxx::json::byte_stream(300, cxx::byte{0x2a}),
+                               "amet"_key >> std::string(70000, 'a')}};
+
+  bool points_into(iovec const& x, void const* first, std::size_t size)
+  {
+    auto const* base = static_cast<char const*>(x.iov_base);
+    auto const* data = static_cast<char const*>(first);
+    return base < data + size && data < base + x.iov_len;
+  }
+
+  template <typename Codec>
+  void encodes_into_chain()
+  {
+    auto const expected = Codec::encode(document);
+    SECTION("content equals encode")
+    {
+      cxx::byte_chain chain(64, 1024);
+      Codec::encode_into(document, cxx::by_ref(chain));
+      REQUIRE(chain.size() == std::size(expected));
+      REQUIRE(chain.flatten() == expected);
+      std::size_t size = 0;
+      for (auto const& x : chain.iovecs()) size += x.iov_len;
+      REQUIRE(size == std::size(expected));
+    }
+    SECTION("large payloads are referenced, small ones copied")
+    {
+      cxx::byte_chain chain(64, 1024);
+      Codec::encode_into(document, cxx::by_ref(chain));
+      auto const& large = cxx::get<std::string>(document["dolor"]["amet"]);
+      auto const& small = cxx::get<cxx::json::byte_stream>(document["dolor"]["sit"]);
+      auto const& pieces = chain.iovecs();
+      REQUIRE(std::count_if(std::begin(pieces), std::end(pieces), [&large](auto const& x) {
+                return x.iov_base == large.data() && x.iov_len == std::size(large);
+              }) == 1);
+      REQUIRE(std::none_of(std::begin(pieces), std::end(pieces), [&small](auto const& x) {
+        return points_into(x, small.data(), std::size(small));
+      }));
+    }
+    SECTION("appends and merges adjacent bytes")
+    {
+      cxx::byte_chain chain;
+      Codec::encode_into(cxx::json{1, 2, 3}, cxx::by_ref(chain));
+      Codec::encode_into(cxx::json{"lorem"_key >> "ipsum"}, cxx::by_ref(chain));
+      auto expect = Codec::encode(cxx::json{1, 2, 3});
+      auto const second = Codec::encode(cxx::json{"lorem"_key >> "ipsum"});
+      expect.insert(std::end(expect), std::begin(second), std::end(second));
+      REQUIRE(chain.flatten() == expect);
+      REQUIRE(std::size(chain.iovecs()) == 1);
+    }
+    SECTION("clear keeps the segments")
+    {
+      cxx::byte_chain chain;
+      Codec::encode_into(document, cxx::by_ref(chain));
+      auto const* first = chain.iovecs().front().iov_base;
+      chain.clear();
+      REQUIRE(chain.empty());
+      REQUIRE(std::empty(chain.iovecs()));
+      Codec::encode_into(document, cxx::by_ref(chain));
+      REQUIRE(chain.iovecs().front().iov_base == first);
+      REQUIRE(chain.flatten() == expected);
+    }
+    SECTION("writev")
+    {
+      cxx::byte_chain chain(64, 1024);
+      Codec::encode_into(document, cxx::by_ref(chain));
+      auto* file = std::tmpfile();
+      REQUIRE(file != nullptr);
+      auto const& pieces = chain.iovecs();
+      REQUIRE(::writev(fileno(file), pieces.data(), static_cast<int>(std::size(pieces))) ==
+              static_cast<ssize_t>(chain.size()));
+      cxx::json::byte_stream read(chain.size());
+      REQUIRE(::pread(fileno(file), read.data(), std::size(read), 0) ==
+              static_cast<ssize_t>(std::size(read)));
+      std::fclose(file);
+      REQUIRE(read == expected);
+    }
+    SECTION("pmr json")
+    {
+      cxx::byte_chain chain(64, 1024);
+      auto const pmr = Codec::decode(expected, std::pmr::new_delete_resource());
+      Codec::encode_into(pmr, cxx::by_ref(chain));
+      REQUIRE(chain.flatten() == expected);
+    }
+  }
+} // namespace
+
+TEST_CASE("cxx::cbor encodes into a byte chain")
+{
+  encodes_into_chain<cxx::cbor>();
+}
+
+TEST_CASE("cxx::msgpack encodes into a byte chain")
+{
+  encodes_into_chain<cxx::msgpack>();
+}
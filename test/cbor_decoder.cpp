@@ -324,6 +324,7 @@ TEST_CASE("indefinite-lenght dictionaries")
   REQUIRE(cbor::decode("bfff"_hex) == cxx::json::dictionary());
   REQUIRE(cbor::decode("bf61616162ff"_hex) == cxx::json::dictionary({{"a", "b"}}));
   REQUIRE(cbor::decode("bf61630061616162ff"_hex) == cxx::json::dictionary({{"a", "b"}, {"c", 0}}));
+  REQUIRE(cbor::decode("a17f61616162ff01"_hex) == cxx::json::dictionary({{"ab", 1}}));
 }
 
 TEST_CASE("indefinite-lenght byte streams")
@@ -0,0 +1,85 @@
+#include "inc/cxx/compact.hpp"
+#include "test/catch.hpp"
+
+using namespace cxx::literals;
+
+TEST_CASE("cxx::compact fits in 16 bytes")
+{
+  REQUIRE(sizeof(cxx::compact) == 16);
+  REQUIRE(sizeof(cxx::compact) < sizeof(cxx::json));
+}
+
+TEST_CASE("cxx::compact stores scalars inline")
+{
+  REQUIRE(cxx::holds_alternative<cxx::compact::null_t>(cxx::compact()));
+  REQUIRE(cxx::get<std::int64_t>(cxx::compact(42)) == 42);
+  REQUIRE(cxx::get<std::int64_t>(cxx::compact(std::numeric_limits<std::int64_t>::min())) ==
+          std::numeric_limits<std::int64_t>::min());
+  REQUIRE(cxx::get<double>(cxx::compact(3.5)) == 3.5);
+  REQUIRE(cxx::get<bool>(cxx::compact(true)) == true);
+  REQUIRE_FALSE(cxx::holds_alternative<std::int64_t>(cxx::compact(true)));
+  REQUIRE_THROWS_AS(cxx::get<double>(cxx::compact(42)), std::bad_variant_access);
+  SECTION("scalars can be modified in place")
+  {
+    cxx::compact x = 41;
+    ++cxx::get<std::int64_t>(x);
+    REQUIRE(x == cxx::compact(42));
+  }
+}
+
+TEST_CASE("cxx::compact exposes strings as std::string_view")
+{
+  for (auto const size : {0u, 1u, 14u, 15u, 16u, 100u})
+  {
+    std::string const text(size, 'x');
+    cxx::compact const x = text;
+    REQUIRE(cxx::holds_alternative<std::string_view>(x));
+    REQUIRE(cxx::get<std::string_view>(x) == text);
+    cxx::compact copy = x;
+    REQUIRE(copy == x);
+    cxx::compact const moved = std::move(copy);
+    REQUIRE(cxx::get<std::string_view>(moved) == text);
+    REQUIRE(std::size(x) == size);
+  }
+  REQUIRE(cxx::compact("lorem") != cxx::compact("ipsum"));
+}
+
+TEST_CASE("cxx::compact holds containers out of line")
+{
+  cxx::compact x = cxx::compact::array{1, "lorem", cxx::compact::dictionary{{"ipsum", 2.5}}};
+  REQUIRE(std::size(x) == 3);
+  REQUIRE(cxx::get<std::int64_t>(x[0]) == 1);
+  REQUIRE(cxx::get<std::string_view>(x[1]) == "lorem");
+  REQUIRE(cxx::get<double>(x[2]["ipsum"]) == 2.5);
+  REQUIRE_THROWS_AS(x[3], std::out_of_range);
+  REQUIRE_THROWS_AS(x["ipsum"], std::bad_variant_access);
+  cxx::get<cxx::compact::array>(x).emplace_back(cxx::compact::byte_stream{cxx::byte{0x2a}});
+  REQUIRE(cxx::get<cxx::compact::byte_stream>(x[3]) ==
+          cxx::compact::byte_stream{cxx::byte{0x2a}});
+  cxx::compact const copy = x;
+  x[2]["ipsum"] = 3.5;
+  REQUIRE(cxx::get<double>(copy[2]["ipsum"]) == 2.5);
+  REQUIRE(copy != x);
+}
+
+TEST_CASE("cxx::visit dispatches on cxx::compact")
+{
+  auto const kind = cxx::overload{[](std::int64_t) { return 1; },
+                                  [](std::string_view) { return 3; },
+                                  [](cxx::compact::null_t) { return 7; },
+                                  [](auto const&) { return 0; }};
+  REQUIRE(cxx::visit(kind, cxx::compact(42)) == 1);
+  REQUIRE(cxx::visit(kind, cxx::compact("lorem ipsum dolor sit amet")) == 3);
+  REQUIRE(cxx::visit(kind, cxx::compact()) == 7);
+  REQUIRE(cxx::visit(kind, cxx::compact(cxx::compact::array())) == 0);
+}
+
+TEST_CASE("cxx::compact can be built from cxx::json")
+{
+  cxx::json const json = {"lorem"_key >> cxx::json{1, 2.5, "ipsum", cxx::json::null},
+                          "dolor"_key >> cxx::json{"sit"_key >> true}};
+  cxx::compact const x(json);
+  REQUIRE(std::size(x) == 2);
+  REQUIRE(x["lorem"] == cxx::compact(cxx::compact::array{1, 2.5, "ipsum", cxx::compact()}));
+  REQUIRE(cxx::get<bool>(x["dolor"]["sit"]));
+}
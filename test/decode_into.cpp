@@ -0,0 +1,108 @@
+#include "inc/cxx/cbor.hpp"
+#include "inc/cxx/msgpack.hpp"
+#include "test/catch.hpp"
+#include "test/utils.hpp"
+
+using namespace cxx::literals;
+using namespace test::literals;
+
+namespace
+{
+  cxx::json message(std::int64_t seq)
+  {
+    return {"seq"_key >> seq,
+            "text"_key >> ("lorem ipsum dolor sit amet, consectetur " + std::to_string(seq)),
+            "blob"_key >> cxx::json::byte_stream(64, cxx::byte{0x2a}),
+            "items"_key >> cxx::json{seq, "sed do eiusmod tempor incididunt ut labore", 2.5},
+            "nested"_key >>
+                cxx::json{"flag"_key >> (seq % 2 == 0), "parent"_key >> cxx::json::null}};
+  }
+
+  template <typename Codec>
+  void decodes_into()
+  {
+    SECTION("result equals a fresh decode")
+    {
+      cxx::json target;
+      Codec::decode_into(Codec::encode(message(1)), cxx::by_ref(target));
+      REQUIRE(target == message(1));
+    }
+    SECTION("allocations of a matching shape are reused")
+    {
+      cxx::json target;
+      Codec::decode_into(Codec::encode(message(1)), cxx::by_ref(target));
+      auto const* text = cxx::get<std::string>(target["text"]).data();
+      auto const* blob = cxx::get<cxx::json::byte_stream>(target["blob"]).data();
+      auto const* items = cxx::get<cxx::json::array>(target["items"]).data();
+      auto const* nested = &*std::begin(cxx::get<cxx::json::dictionary>(target["nested"]));
+      Codec::decode_into(Codec::encode(message(2)), cxx::by_ref(target));
+      REQUIRE(target == message(2));
+      REQUIRE(cxx::get<std::string>(target["text"]).data() == text);
+      REQUIRE(cxx::get<cxx::json::byte_stream>(target["blob"]).data() == blob);
+      REQUIRE(cxx::get<cxx::json::array>(target["items"]).data() == items);
+      REQUIRE(&*std::begin(cxx::get<cxx::json::dictionary>(target["nested"])) == nested);
+    }
+    SECTION("a different shape replaces the old one")
+    {
+      cxx::json target = message(1);
+      cxx::json const other = {"items"_key >> cxx::json{1}, "seq"_key >> "two",
+                               "zzz"_key >> cxx::json{"a"_key >> 1}};
+      Codec::decode_into(Codec::encode(other), cxx::by_ref(target));
+      REQUIRE(target == other);
+      Codec::decode_into(Codec::encode(cxx::json{1, 2, 3}), cxx::by_ref(target));
+      REQUIRE(target == cxx::json{1, 2, 3});
+      Codec::decode_into(Codec::encode(cxx::json{}), cxx::by_ref(target));
+      REQUIRE(target == cxx::json{});
+      Codec::decode_into(Codec::encode(message(3)), cxx::by_ref(target));
+      REQUIRE(target == message(3));
+    }
+    SECTION("byte views advance past the decoded node")
+    {
+      auto const bytes = Codec::encode(message(1));
+      cxx::json::byte_view data(bytes.data(), std::size(bytes));
+      cxx::json target;
+      Codec::decode_into(cxx::by_ref(data), cxx::by_ref(target));
+      REQUIRE(std::empty(data));
+    }
+  }
+} // namespace
+
+TEST_CASE("cxx::cbor decodes into an existing json")
+{
+  decodes_into<cxx::cbor>();
+  SECTION("unordered and duplicate keys")
+  {
+    cxx::json target = {"a"_key >> "lorem", "c"_key >> 3};
+    cxx::cbor::decode_into("a3616201616102616203"_hex, cxx::by_ref(target));
+    REQUIRE(target == cxx::cbor::decode("a3616201616102616203"_hex));
+  }
+  SECTION("indefinite-length strings and byte streams")
+  {
+    cxx::json target = cxx::json{"lorem", cxx::json::byte_stream{cxx::byte{0x00}}};
+    cxx::cbor::decode_into("827f6261626163ff5f4201024103ff"_hex, cxx::by_ref(target));
+    REQUIRE(target == cxx::cbor::decode("827f6261626163ff5f4201024103ff"_hex));
+  }
+  SECTION("invalid input throws")
+  {
+    cxx::json target = message(1);
+    REQUIRE_THROWS_AS(cxx::cbor::decode_into("a2616101"_hex, cxx::by_ref(target)),
+                      cxx::cbor::truncation_error);
+  }
+}
+
+TEST_CASE("cxx::msgpack decodes into an existing json")
+{
+  decodes_into<cxx::msgpack>();
+  SECTION("unordered and duplicate keys")
+  {
+    cxx::json target = {"a"_key >> "lorem", "c"_key >> 3};
+    cxx::msgpack::decode_into("83a16201a16102a16203"_hex, cxx::by_ref(target));
+    REQUIRE(target == cxx::msgpack::decode("83a16201a16102a16203"_hex));
+  }
+  SECTION("invalid input throws")
+  {
+    cxx::json target = message(1);
+    REQUIRE_THROWS_AS(cxx::msgpack::decode_into("82a16101"_hex, cxx::by_ref(target)),
+                      cxx::msgpack::truncation_error);
+  }
+}
@@ -0,0 +1,95 @@
+#include "inc/cxx/cbor.hpp"
+#include "inc/cxx/msgpack.hpp"
+#include "test/catch.hpp"
+#include "test/utils.hpp"
+
+using namespace cxx::literals;
+using namespace test::literals;
+
+namespace
+{
+  cxx::json const document = {
+      "lorem"_key >> cxx::json{1, -100, 70000, -2.5, "ipsum", cxx::json::null, true, false},
+      "dolor"_key >> cxx::json{"sit"_key >> cxx::json::byte_stream(300, cxx::byte{0x2a}),
+                               "amet"_key >> std::string(1000, 'a'),
+                               "consectetur adipiscing elit"_key >> cxx::json::array()},
+      ""_key >> cxx::json::dictionary()};
+
+  /*
+   * bytes cut at each of the offsets
+   */
+  std::vector<cxx::json::byte_view> cut(cxx::json::byte_stream const& bytes,
+                                        std::vector<std::size_t> const& offsets)
+  {
+    std::vector<cxx::json::byte_view> ret;
+    std::size_t first = 0;
+    for (auto x : offsets)
+    {
+      ret.emplace_back(bytes.data() + first, x - first);
+      first = x;
+    }
+    ret.emplace_back(bytes.data() + first, std::size(bytes) - first);
+    return ret;
+  }
+
+  template <typename Codec>
+  void decodes_segments(cxx::json::byte_stream const& bytes)
+  {
+    auto const expected = Codec::decode(bytes);
+    SECTION("single segment")
+    {
+      REQUIRE(Codec::decode(cut(bytes, {})) == expected);
+    }
+    SECTION("two segments cut anywhere")
+    {
+      for (std::size_t i = 0; i <= std::size(bytes); ++i)
+        REQUIRE(Codec::decode(cut(bytes, {i})) == expected);
+    }
+    SECTION("one byte segments and empty ones")
+    {
+      std::vector<std::size_t> offsets;
+      for (std::size_t i = 0; i <= std::size(bytes); ++i)
+      {
+        offsets.push_back(i);
+        offsets.push_back(i);
+      }
+      REQUIRE(Codec::decode(cut(bytes, offsets)) == expected);
+    }
+    SECTION("truncated input throws")
+    {
+      for (std::size_t i = 0; i < std::size(bytes); ++i)
+      {
+        auto segments = cut(bytes, {i / 2});
+        segments.back() = segments.back().substr(0, i - i / 2);
+        REQUIRE_THROWS_AS(Codec::decode(segments), typename Codec::truncation_error);
+      }
+      REQUIRE_THROWS_AS(Codec::decode(std::vector<cxx::json::byte_view>()),
+                        typename Codec::truncation_error);
+    }
+  }
+
+  template <typename Codec>
+  void decodes_chain()
+  {
+    cxx::byte_chain chain(64, 512);
+    Codec::encode_into(document, cxx::by_ref(chain));
+    REQUIRE(std::size(chain.iovecs()) > 1);
+    REQUIRE(Codec::decode(chain.iovecs()) == document);
+  }
+} // namespace
+
+TEST_CASE("cxx::cbor decodes a sequence of segments")
+{
+  SECTION("document") { decodes_segments<cxx::cbor>(cxx::cbor::encode(document)); }
+  SECTION("indefinite-length strings, byte streams and containers")
+  {
+    decodes_segments<cxx::cbor>("837f6261626163ff5f4201024103ffbf616101ff"_hex);
+  }
+  SECTION("byte chain iovecs") { decodes_chain<cxx::cbor>(); }
+}
+
+TEST_CASE("cxx::msgpack decodes a sequence of segments")
+{
+  SECTION("document") { decodes_segments<cxx::msgpack>(cxx::msgpack::encode(document)); }
+  SECTION("byte chain iovecs") { decodes_chain<cxx::msgpack>(); }
+}
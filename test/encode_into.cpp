@@ -0,0 +1,63 @@
+#include "inc/cxx/cbor.hpp"
+#include "inc/cxx/msgpack.hpp"
+#include "test/catch.hpp"
+#include "test/utils.hpp"
+
+using namespace cxx::literals;
+using namespace test::literals;
+
+namespace
+{
+  cxx::json const document = {
+      "lorem"_key >> cxx::json{1, -2.5, "ipsum dolor sit amet, consectetur adipiscing elit",
+                               cxx::json::null, true},
+      "sed"_key >> cxx::json{"do"_key >> cxx::json::byte_stream(300, cxx::byte{0x2a}),
+                             "eiusmod tempor incididunt ut labore"_key >> "et dolore magna"}};
+
+  template <typename Codec>
+  void encodes_into()
+  {
+    SECTION("appends to existing content")
+    {
+      auto out = "ff"_hex;
+      Codec::encode_into(document, cxx::by_ref(out));
+      Codec::encode_into(42, cxx::by_ref(out));
+      auto expected = "ff"_hex;
+      auto const first = Codec::encode(document);
+      auto const second = Codec::encode(42);
+      expected.insert(std::end(expected), std::begin(first), std::end(first));
+      expected.insert(std::end(expected), std::begin(second), std::end(second));
+      REQUIRE(out == expected);
+    }
+    SECTION("a reused buffer stops reallocating")
+    {
+      cxx::json::byte_stream out;
+      Codec::encode_into(document, cxx::by_ref(out));
+      auto const* data = out.data();
+      for (int i = 0; i < 3; ++i)
+      {
+        out.clear();
+        Codec::encode_into(document, cxx::by_ref(out));
+        REQUIRE(out == Codec::encode(document));
+        REQUIRE(out.data() == data);
+      }
+    }
+    SECTION("pmr json")
+    {
+      auto const bytes = Codec::encode(document);
+      cxx::json::byte_stream out;
+      Codec::encode_into(Codec::decode(bytes, std::pmr::new_delete_resource()), cxx::by_ref(out));
+      REQUIRE(out == bytes);
+    }
+  }
+} // namespace
+
+TEST_CASE("cxx::cbor encodes into a caller owned buffer")
+{
+  encodes_into<cxx::cbor>();
+}
+
+TEST_CASE("cxx::msgpack encodes into a caller owned buffer")
+{
+  encodes_into<cxx::msgpack>();
+}
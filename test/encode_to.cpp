@@ -0,0 +1,58 @@
+#include "inc/cxx/cbor.hpp"
+#include "inc/cxx/msgpack.hpp"
+#include "test/catch.hpp"
+
+using namespace cxx::literals;
+
+namespace
+{
+  cxx::json const document = {
+      "lorem"_key >> cxx::json{1, -100, 70000, -2.5, "ipsum", cxx::json::null, true},
+      "dolor"_key >> cxx::json{"sit"_key >> cxx::json::byte_stream(300, cxx::byte{0x2a}),
+                               "amet"_key >> std::string(70000, 'a')}};
+
+  template <typename Codec>
+  void encodes_to()
+  {
+    auto const expected = Codec::encode(document);
+    auto const size = std::size(expected);
+    SECTION("exact fit")
+    {
+      cxx::json::byte_stream out(size);
+      REQUIRE(Codec::encode_to(document, out.data(), size) == size);
+      REQUIRE(out == expected);
+    }
+    SECTION("bytes past the encoding are left alone")
+    {
+      cxx::json::byte_stream out(size + 8, cxx::byte{0x5a});
+      REQUIRE(Codec::encode_to(document, out.data(), std::size(out)) == size);
+      REQUIRE(std::equal(std::begin(expected), std::end(expected), std::begin(out)));
+      REQUIRE(std::all_of(std::begin(out) + static_cast<std::ptrdiff_t>(size), std::end(out),
+                          [](auto x) { return x == cxx::byte{0x5a}; }));
+    }
+    SECTION("overflow writes nothing")
+    {
+      cxx::json::byte_stream out(size - 1, cxx::byte{0x5a});
+      REQUIRE_FALSE(Codec::encode_to(document, out.data(), std::size(out)));
+      REQUIRE(out == cxx::json::byte_stream(size - 1, cxx::byte{0x5a}));
+      REQUIRE_FALSE(Codec::encode_to(cxx::json::null, nullptr, 0));
+    }
+    SECTION("pmr json")
+    {
+      cxx::json::byte_stream out(size);
+      auto const pmr = Codec::decode(expected, std::pmr::new_delete_resource());
+      REQUIRE(Codec::encode_to(pmr, out.data(), size) == size);
+      REQUIRE(out == expected);
+    }
+  }
+} // namespace
+
+TEST_CASE("cxx::cbor encodes to a fixed region")
+{
+  encodes_to<cxx::cbor>();
+}
+
+TEST_CASE("cxx::msgpack encodes to a fixed region")
+{
+  encodes_to<cxx::msgpack>();
+}
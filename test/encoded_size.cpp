@@ -0,0 +1,77 @@
+#include "inc/cxx/cbor.hpp"
+#include "inc/cxx/msgpack.hpp"
+#include "test/catch.hpp"
+
+using namespace cxx::literals;
+
+namespace
+{
+  std::vector<cxx::json> const samples = {
+      cxx::json::null,
+      true,
+      0,
+      23,
+      24,
+      -24,
+      -25,
+      -32,
+      -33,
+      127,
+      128,
+      255,
+      256,
+      -129,
+      65535,
+      65536,
+      -65537,
+      std::numeric_limits<std::int64_t>::max(),
+      std::numeric_limits<std::int64_t>::min(),
+      2.5,
+      "",
+      std::string(23, 'a'),
+      std::string(24, 'a'),
+      std::string(70000, 'a'),
+      cxx::json::byte_stream(300, cxx::byte{0x2a}),
+      cxx::json::array(),
+      cxx::json::dictionary(),
+      {"lorem"_key >> cxx::json{1, -2.5, "ipsum", cxx::json::null, true},
+       "dolor"_key >> cxx::json{"sit"_key >> cxx::json::byte_stream(30, cxx::byte{0x01})}}};
+
+  template <typename Codec>
+  void encoded_sizes()
+  {
+    SECTION("matches the encoded bytes")
+    {
+      for (auto const& x : samples)
+      {
+        CAPTURE(std::size(Codec::encode(x)));
+        REQUIRE(Codec::encoded_size(x) == std::size(Codec::encode(x)));
+      }
+    }
+    SECTION("a buffer of that size is not regrown")
+    {
+      auto const& x = samples.back();
+      auto out = cxx::json::byte_stream();
+      out.reserve(Codec::encoded_size(x));
+      auto const* data = out.data();
+      Codec::encode_into(x, cxx::by_ref(out));
+      REQUIRE(out.data() == data);
+    }
+    SECTION("pmr json")
+    {
+      auto const bytes = Codec::encode(samples.back());
+      REQUIRE(Codec::encoded_size(Codec::decode(bytes, std::pmr::new_delete_resource())) ==
+              std::size(bytes));
+    }
+  }
+} // namespace
+
+TEST_CASE("cxx::cbor computes the encoded size")
+{
+  encoded_sizes<cxx::cbor>();
+}
+
+TEST_CASE("cxx::msgpack computes the encoded size")
+{
+  encoded_sizes<cxx::msgpack>();
+}
@@ -0,0 +1,91 @@
+#include "inc/cxx/flat_map.hpp"
+#include "test/catch.hpp"
+#include <map>
+#include <string>
+
+namespace
+{
+  using map = cxx::flat_map<std::string, int>;
+
+  auto const keys = [](map const& x) {
+    std::vector<std::string> ret;
+    for (auto const& [key, value] : x) ret.push_back(key);
+    return ret;
+  };
+} // namespace
+
+TEST_CASE("cxx::flat_map iterates in key order")
+{
+  map x = {{"lorem", 1}, {"ipsum", 2}, {"dolor", 3}, {"sit", 4}, {"amet", 5}};
+  REQUIRE(keys(x) == std::vector<std::string>{"amet", "dolor", "ipsum", "lorem", "sit"});
+  x.try_emplace("consectetur", 6);
+  x["zzz"] = 7;
+  x.emplace("aaa", 8);
+  REQUIRE(keys(x) == std::vector<std::string>{"aaa", "amet", "consectetur", "dolor", "ipsum",
+                                              "lorem", "sit", "zzz"});
+}
+
+TEST_CASE("cxx::flat_map keeps first of duplicated keys")
+{
+  map x = {{"lorem", 1}, {"ipsum", 2}, {"lorem", 3}};
+  REQUIRE(std::size(x) == 2);
+  REQUIRE(x.at("lorem") == 1);
+  auto const [it, inserted] = x.try_emplace("ipsum", 4);
+  REQUIRE_FALSE(inserted);
+  REQUIRE(it->second == 2);
+  REQUIRE_FALSE(x.insert({"ipsum", 5}).second);
+  REQUIRE(x.at("ipsum") == 2);
+}
+
+TEST_CASE("cxx::flat_map finds keys in small and large maps")
+{
+  for (auto const size : {0, 1, 15, 16, 17, 100})
+  {
+    map x;
+    for (int i = size - 1; i >= 0; --i) x.try_emplace(std::to_string(i * 3), i);
+    REQUIRE(std::size(x) == static_cast<std::size_t>(size));
+    for (int i = 0; i < size; ++i)
+    {
+      REQUIRE(x.find(std::to_string(i * 3)) != std::end(x));
+      REQUIRE(x.at(std::to_string(i * 3)) == i);
+      REQUIRE(x.find(std::to_string(i * 3 + 1)) == std::end(x));
+      REQUIRE(x.count(std::string_view("x")) == 0);
+    }
+    REQUIRE_THROWS_AS(x.at("missing"), std::out_of_range);
+  }
+}
+
+TEST_CASE("cxx::flat_map honors insertion hints")
+{
+  map x;
+  for (int i = 0; i < 10; ++i) x.try_emplace(std::end(x), std::to_string(i), i);
+  REQUIRE(keys(x) ==
+          std::vector<std::string>{"0", "1", "2", "3", "4", "5", "6", "7", "8", "9"});
+  SECTION("wrong hint falls back to search")
+  {
+    x.try_emplace(std::begin(x), "5a", 42);
+    x.try_emplace(std::end(x), "0a", 43);
+    x.emplace_hint(std::begin(x), "3", 44);
+    REQUIRE(std::size(x) == 12);
+    REQUIRE(x.at("5a") == 42);
+    REQUIRE(x.at("0a") == 43);
+    REQUIRE(x.at("3") == 3);
+  }
+}
+
+TEST_CASE("cxx::flat_map can erase items")
+{
+  map x = {{"lorem", 1}, {"ipsum", 2}, {"dolor", 3}};
+  REQUIRE(x.erase("ipsum") == 1);
+  REQUIRE(x.erase("ipsum") == 0);
+  x.erase(std::begin(x));
+  REQUIRE(keys(x) == std::vector<std::string>{"lorem"});
+}
+
+TEST_CASE("cxx::flat_map can be built from std::map")
+{
+  std::map<std::string, int> const orig = {{"lorem", 1}, {"ipsum", 2}};
+  map const x(orig);
+  REQUIRE(x == map{{"ipsum", 2}, {"lorem", 1}});
+  REQUIRE(x != map{{"ipsum", 2}});
+}
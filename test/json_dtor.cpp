@@ -0,0 +1,79 @@
+#include "inc/cxx/json.hpp"
+#include "test/catch.hpp"
+#include <memory_resource>
+
+namespace
+{
+  template <typename Json>
+  void nest(cxx::by_ref<Json> root, std::size_t depth)
+  {
+    auto* node = &root.get();
+    for (std::size_t i = 0; i < depth; ++i)
+    {
+      auto& items = cxx::get<typename Json::array>(*node);
+      items.emplace_back(static_cast<std::int64_t>(i));
+      if (i % 2 == 0)
+      {
+        items.emplace_back(typename Json::array(items.get_allocator()));
+        node = &items.back();
+      }
+      else
+      {
+        typename Json::dictionary dict(items.get_allocator());
+        dict.try_emplace(typename Json::string("next", items.get_allocator()),
+                         typename Json::array(items.get_allocator()));
+        items.emplace_back(std::move(dict));
+        node = &cxx::get<typename Json::dictionary>(items.back()).begin()->second;
+      }
+    }
+  }
+
+  struct counting : std::pmr::memory_resource {
+    void* do_allocate(std::size_t bytes, std::size_t align) override
+    {
+      outstanding += bytes;
+      return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t align) override
+    {
+      outstanding -= bytes;
+      std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+    bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+    {
+      return this == &other;
+    }
+    std::size_t outstanding = 0;
+  };
+} // namespace
+
+TEST_CASE("cxx::json destroys trees deeper than the stack allows")
+{
+  cxx::json root = cxx::json::array();
+  nest(cxx::by_ref(root), 1'000'000);
+  REQUIRE(std::size(root) == 2);
+  REQUIRE(cxx::get<std::int64_t>(root[1][1]["next"][0]) == 2);
+}
+
+TEST_CASE("cxx::pmr::json returns memory of deep trees to its resource")
+{
+  counting resource;
+  {
+    auto root = cxx::pmr::json(cxx::pmr::json::array(&resource));
+    nest(cxx::by_ref(root), 100'000);
+    REQUIRE(resource.outstanding > 0);
+  }
+  REQUIRE(resource.outstanding == 0);
+}
+
+TEST_CASE("cxx::json destroys wide trees")
+{
+  cxx::json::array items;
+  for (std::int64_t i = 0; i < 1000; ++i)
+    items.push_back(cxx::json::dictionary{{"lorem", cxx::json{i, "ipsum"}}, {"dolor", i}});
+  cxx::json root = std::move(items);
+  cxx::json const copy = root;
+  root = cxx::json::null;
+  REQUIRE(std::size(copy) == 1000);
+  REQUIRE(cxx::get<std::int64_t>(copy[999]["lorem"][0]) == 999);
+}
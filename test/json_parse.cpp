@@ -0,0 +1,138 @@
+#include "inc/cxx/json.hpp"
+#include "test/catch.hpp"
+#include "test/utils.hpp"
+
+using namespace cxx::literals;
+
+TEST_CASE("can parse simple values")
+{
+  REQUIRE(cxx::parse("null") == cxx::json::null);
+  REQUIRE(cxx::parse("true") == true);
+  REQUIRE(cxx::parse("false") == false);
+  REQUIRE(cxx::parse(" \t\r\n42 \n") == 42);
+  REQUIRE(cxx::parse("\"lorem\"") == "lorem");
+  REQUIRE_THROWS_AS(cxx::parse(""), cxx::parse_error);
+  REQUIRE_THROWS_AS(cxx::parse("   "), cxx::parse_error);
+  REQUIRE_THROWS_AS(cxx::parse("nul"), cxx::parse_error);
+  REQUIRE_THROWS_AS(cxx::parse("nill"), cxx::parse_error);
+  REQUIRE_THROWS_AS(cxx::parse("True"), cxx::parse_error);
+  REQUIRE_THROWS_AS(cxx::parse("true false"), cxx::parse_error);
+}
+
+TEST_CASE("can parse numbers")
+{
+  SECTION("integers")
+  {
+    REQUIRE(cxx::parse("0") == 0);
+    REQUIRE(cxx::parse("-1") == -1);
+    REQUIRE(cxx::parse("1234567890") == 1234567890);
+    REQUIRE(cxx::parse("9223372036854775807") == std::numeric_limits<std::int64_t>::max());
+    REQUIRE(cxx::parse("-9223372036854775808") == std::numeric_limits<std::int64_t>::min());
+  }
+  SECTION("integers out of std::int64_t range become floating point values")
+  {
+    REQUIRE(cxx::parse("9223372036854775808") == 9223372036854775808.0);
+    REQUIRE(cxx::parse("-9223372036854775809") == -9223372036854775809.0);
+    REQUIRE(cxx::parse("123456789012345678901234567890") == 123456789012345678901234567890.0);
+  }
+  SECTION("floating point values")
+  {
+    REQUIRE(cxx::parse("3.14") == 3.14);
+    REQUIRE(cxx::parse("-0.5") == -0.5);
+    REQUIRE(cxx::parse("0.000001") == 0.000001);
+    REQUIRE(cxx::parse("1e3") == 1000.0);
+    REQUIRE(cxx::parse("1E+3") == 1000.0);
+    REQUIRE(cxx::parse("25e-1") == 2.5);
+    REQUIRE(cxx::parse("1.7976931348623157e308") == std::numeric_limits<double>::max());
+    REQUIRE(cxx::parse("4.9406564584124654e-324") == std::numeric_limits<double>::denorm_min());
+    REQUIRE(cxx::parse("0.1000000000000000055511151231257827") == 0.1);
+    REQUIRE(cxx::parse("1e-400") == 0.0);
+  }
+  SECTION("malformed numbers")
+  {
+    REQUIRE_THROWS_AS(cxx::parse("-"), cxx::parse_error);
+    REQUIRE_THROWS_AS(cxx::parse("01"), cxx::parse_error);
+    REQUIRE_THROWS_AS(cxx::parse("1."), cxx::parse_error);
+    REQUIRE_THROWS_AS(cxx::parse(".5"), cxx::parse_error);
+    REQUIRE_THROWS_AS(cxx::parse("1e"), cxx::parse_error);
+    REQUIRE_THROWS_AS(cxx::parse("1e+"), cxx::parse_error);
+    REQUIRE_THROWS_AS(cxx::parse("+1"), cxx::parse_error);
+    REQUIRE_THROWS_AS(cxx::parse("1e400"), cxx::parse_error);
+  }
+}
+
+TEST_CASE("can parse strings")
+{
+  REQUIRE(cxx::parse("\"\"") == "");
+  REQUIRE(cxx::parse(R"("lorem \"ipsum\" dolor")") == "lorem \"ipsum\" dolor");
+  REQUIRE(cxx::parse(R"("\\\/\b\f\n\r\t")") == "\\/\b\f\n\r\t");
+  REQUIRE(cxx::parse(R"("Aé€")") == "A\xc3\xa9\xe2\x82\xac");
+  REQUIRE(cxx::parse(R"("😀")") == "\xf0\x9f\x98\x80");
+  REQUIRE(cxx::parse("\"za\xc5\xbc\xc3\xb3\xc5\x82\xc4\x87\"") ==
+          "za\xc5\xbc\xc3\xb3\xc5\x82\xc4\x87");
+  REQUIRE_THROWS_AS(cxx::parse("\"lorem"), cxx::parse_error);
+  REQUIRE_THROWS_AS(cxx::parse("\"lorem\\"), cxx::parse_error);
+  REQUIRE_THROWS_AS(cxx::parse("\"lorem\nipsum\""), cxx::parse_error);
+  REQUIRE_THROWS_AS(cxx::parse(R"("\x")"), cxx::parse_error);
+  REQUIRE_THROWS_AS(cxx::parse(R"("\u12")"), cxx::parse_error);
+  REQUIRE_THROWS_AS(cxx::parse(R"("\u12g4")"), cxx::parse_error);
+  REQUIRE_THROWS_AS(cxx::parse(R"("\ud83d")"), cxx::parse_error);
+  REQUIRE_THROWS_AS(cxx::parse(R"("\ud83dA")"), cxx::parse_error);
+  REQUIRE_THROWS_AS(cxx::parse(R"("\ude00")"), cxx::parse_error);
+}
+
+TEST_CASE("can parse arrays")
+{
+  REQUIRE(cxx::parse("[]") == cxx::json::array());
+  REQUIRE(cxx::parse("[ ]") == cxx::json::array());
+  REQUIRE(cxx::parse("[1, \"lorem\", [true, null], []]") ==
+          cxx::json{1, "lorem", {true, cxx::json::null}, cxx::json::array()});
+  REQUIRE_THROWS_AS(cxx::parse("["), cxx::parse_error);
+  REQUIRE_THROWS_AS(cxx::parse("[1"), cxx::parse_error);
+  REQUIRE_THROWS_AS(cxx::parse("[1,]"), cxx::parse_error);
+  REQUIRE_THROWS_AS(cxx::parse("[1 2]"), cxx::parse_error);
+  REQUIRE_THROWS_AS(cxx::parse("[,]"), cxx::parse_error);
+}
+
+TEST_CASE("can parse dictionaries")
+{
+  REQUIRE(cxx::parse("{}") == cxx::json::dictionary());
+  REQUIRE(cxx::parse(R"({"lorem": 42, "ipsum": {"dolor": [3.5]}, "sit\n": null})") ==
+          cxx::json{"lorem"_key >> 42, "ipsum"_key >> cxx::json{"dolor"_key >> cxx::json{3.5}},
+                    "sit\n"_key >> cxx::json::null});
+  SECTION("keeps first value of duplicated key")
+  {
+    REQUIRE(cxx::parse(R"({"lorem": 1, "lorem": 2})") == cxx::json{"lorem"_key >> 1});
+  }
+  REQUIRE_THROWS_AS(cxx::parse("{"), cxx::parse_error);
+  REQUIRE_THROWS_AS(cxx::parse("{42: 1}"), cxx::parse_error);
+  REQUIRE_THROWS_AS(cxx::parse(R"({"lorem" 1})"), cxx::parse_error);
+  REQUIRE_THROWS_AS(cxx::parse(R"({"lorem": 1,})"), cxx::parse_error);
+  REQUIRE_THROWS_AS(cxx::parse(R"({"lorem": 1 "ipsum": 2})"), cxx::parse_error);
+}
+
+TEST_CASE("parse limits nesting level")
+{
+  auto const nested = [](std::size_t n) { return std::string(n, '[') + std::string(n, ']'); };
+  REQUIRE_NOTHROW(cxx::parse(nested(62)));
+  REQUIRE_THROWS_AS(cxx::parse(nested(63)), cxx::parse_error);
+}
+
+TEST_CASE("parse can consume json texts from the front of input")
+{
+  std::string_view text = R"( {"lorem": 1} [2]  "ipsum" 3)";
+  REQUIRE(cxx::parse(cxx::by_ref(text)) == cxx::json{"lorem"_key >> 1});
+  REQUIRE(std::size(text) == 14);
+  REQUIRE(cxx::parse(cxx::by_ref(text)) == cxx::json{2});
+  REQUIRE(cxx::parse(cxx::by_ref(text)) == "ipsum");
+  REQUIRE(cxx::parse(cxx::by_ref(text)) == 3);
+  REQUIRE(std::empty(text));
+  REQUIRE_THROWS_AS(cxx::parse(cxx::by_ref(text)), cxx::parse_error);
+}
+
+TEST_CASE("parse restores output of to_string")
+{
+  cxx::json const json = {"lorem"_key >> cxx::json{1, 2.5, "ipsum \"dolor\" \\"},
+                          "sit"_key >> cxx::json{"amet"_key >> true}, "nil"_key >> cxx::json::null};
+  REQUIRE(cxx::parse(cxx::to_string(json)) == json);
+}
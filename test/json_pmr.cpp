@@ -0,0 +1,76 @@
+#include "inc/cxx/cbor.hpp"
+#include "inc/cxx/msgpack.hpp"
+#include "test/catch.hpp"
+#include <memory_resource>
+
+using namespace cxx::literals;
+
+namespace
+{
+  /*
+   * any allocation which bypasses the resource passed to decode throws std::bad_alloc
+   */
+  struct forbid_default_resource {
+    forbid_default_resource()
+        : previous(std::pmr::set_default_resource(std::pmr::null_memory_resource()))
+    {
+    }
+
+    ~forbid_default_resource() { std::pmr::set_default_resource(previous); }
+    std::pmr::memory_resource* const previous;
+  };
+
+  cxx::json const document = {
+      "lorem"_key >> cxx::json{1, -2.5, "ipsum dolor sit amet, consectetur adipiscing elit",
+                               cxx::json::null, true},
+      "sed"_key >> cxx::json{"do"_key >> cxx::json::byte_stream{cxx::byte{0x2a}, cxx::byte{0x2b}},
+                             "eiusmod tempor incididunt ut labore"_key >> "et dolore magna"},
+      "aliqua"_key >> cxx::json::array{}};
+
+  template <typename Codec>
+  void decodes_into(std::pmr::monotonic_buffer_resource& arena)
+  {
+    auto const bytes = Codec::encode(document);
+    auto const json = [&] {
+      forbid_default_resource const guard;
+      return Codec::decode(bytes, &arena);
+    }();
+    REQUIRE(Codec::encode(json) == bytes);
+    auto const& dict = cxx::get<cxx::pmr::json::dictionary>(json);
+    REQUIRE(dict.get_allocator().resource() == &arena);
+    REQUIRE(std::begin(dict)->first.get_allocator().resource() == &arena);
+    auto const& array = cxx::get<cxx::pmr::json::array>(json["lorem"]);
+    REQUIRE(array.get_allocator().resource() == &arena);
+    REQUIRE(cxx::get<cxx::pmr::json::string>(array[2]).get_allocator().resource() == &arena);
+    REQUIRE(cxx::get<cxx::pmr::json::byte_stream>(json["sed"]["do"]).get_allocator().resource() ==
+            &arena);
+  }
+} // namespace
+
+TEST_CASE("cxx::pmr::json holds the same values as cxx::json")
+{
+  cxx::pmr::json x;
+  x["lorem"] = 1;
+  x["ipsum"] = 2;
+  REQUIRE(std::size(x) == 2);
+  REQUIRE(x["lorem"] == 1);
+  x["dolor"] = cxx::pmr::json::array{1, 2.5, "sit", cxx::json::null};
+  REQUIRE(std::size(x["dolor"]) == 4);
+  REQUIRE(x["dolor"][2] == cxx::pmr::json::string("sit"));
+  REQUIRE(x != cxx::pmr::json());
+  cxx::json const expected = {"lorem"_key >> 1, "ipsum"_key >> 2,
+                              "dolor"_key >> cxx::json{1, 2.5, "sit", cxx::json::null}};
+  REQUIRE(cxx::msgpack::encode(x) == cxx::msgpack::encode(expected));
+}
+
+TEST_CASE("cbor can decode into a memory resource")
+{
+  std::pmr::monotonic_buffer_resource arena;
+  decodes_into<cxx::cbor>(arena);
+}
+
+TEST_CASE("msgpack can decode into a memory resource")
+{
+  std::pmr::monotonic_buffer_resource arena;
+  decodes_into<cxx::msgpack>(arena);
+}
@@ -9,7 +9,7 @@ TEST_CASE("can serialize simple values to string")
   using namespace cxx::literals;
   REQUIRE(cxx::to_string(cxx::json::null) == "null");
   REQUIRE(cxx::to_string(42) == "42");
-  REQUIRE(cxx::to_string(3.14) == "3.140000");
+  REQUIRE(cxx::to_string(3.14) == "3.14");
   REQUIRE(cxx::to_string(true) == "true");
   REQUIRE(cxx::to_string(false) == "false");
   REQUIRE(cxx::to_string("lorem \"ipsum\" dolor") == "\"lorem \\\"ipsum\\\" dolor\"");
@@ -21,3 +21,87 @@ TEST_CASE("can serialize simple values to string")
                           "sit"_key >> "amet"}) ==
           "{\"dolor\": null, \"ipsum\": true, \"lorem\": 42, \"sit\": \"amet\"}");
 }
+
+TEST_CASE("can serialize integers")
+{
+  REQUIRE(cxx::to_string(0) == "0");
+  REQUIRE(cxx::to_string(7) == "7");
+  REQUIRE(cxx::to_string(-10) == "-10");
+  REQUIRE(cxx::to_string(1234567890) == "1234567890");
+  REQUIRE(cxx::to_string(std::numeric_limits<std::int64_t>::max()) == "9223372036854775807");
+  REQUIRE(cxx::to_string(std::numeric_limits<std::int64_t>::min()) == "-9223372036854775808");
+}
+
+TEST_CASE("can serialize nested documents")
+{
+  using namespace cxx::literals;
+  REQUIRE(cxx::to_string({{1, {2, cxx::json::array()}}, cxx::json{"lorem"_key >> cxx::json{3}}}) ==
+          "[[1, [2, []]], {\"lorem\": [3]}]");
+}
+
+TEST_CASE("can serialize into existing string")
+{
+  std::string out = "lorem ipsum dolor sit amet consectetur adipiscing elit";
+  auto const capacity = out.capacity();
+  cxx::to_string({42, "lorem"}, cxx::by_ref(out));
+  REQUIRE(out == "[42, \"lorem\"]");
+  REQUIRE(out.capacity() == capacity);
+}
+
+TEST_CASE("can serialize floating point values")
+{
+  REQUIRE(cxx::to_string(0.0) == "0.0");
+  REQUIRE(cxx::to_string(-0.0) == "-0.0");
+  REQUIRE(cxx::to_string(1.0) == "1.0");
+  REQUIRE(cxx::to_string(-42.0) == "-42.0");
+  REQUIRE(cxx::to_string(0.1) == "0.1");
+  REQUIRE(cxx::to_string(0.3) == "0.3");
+  REQUIRE(cxx::to_string(123456.789) == "123456.789");
+  REQUIRE(cxx::to_string(0.0001) == "0.0001");
+  REQUIRE(cxx::to_string(1e-5) == "1e-5");
+  REQUIRE(cxx::to_string(1e15) == "1e15");
+  REQUIRE(cxx::to_string(123456789012345.0) == "123456789012345.0");
+  REQUIRE(cxx::to_string(1.5e300) == "1.5e300");
+  REQUIRE(cxx::to_string(std::numeric_limits<double>::max()) == "1.7976931348623157e308");
+  REQUIRE(cxx::to_string(std::numeric_limits<double>::denorm_min()) == "5e-324");
+  REQUIRE(cxx::to_string(std::numeric_limits<double>::infinity()) == "null");
+  REQUIRE(cxx::to_string(std::numeric_limits<double>::quiet_NaN()) == "null");
+}
+
+TEST_CASE("floating point values survive text round trip")
+{
+  for (auto const x : {0.1, 1.0 / 3.0, 2.0 / 3.0, 3.141592653589793, 6.02214076e23, 1.602176634e-19,
+                       2.2250738585072014e-308, 9007199254740993.0, -1234.5678e-90})
+  {
+    auto const json = cxx::parse(cxx::to_string(x));
+    REQUIRE(cxx::holds_alternative<double>(json));
+    REQUIRE(cxx::get<double>(json) == x);
+  }
+}
+
+TEST_CASE("can serialize strings with characters that need escaping")
+{
+  using namespace cxx::literals;
+  REQUIRE(cxx::to_string("\\") == "\"\\\\\"");
+  REQUIRE(cxx::to_string("\b\f\n\r\t") == "\"\\b\\f\\n\\r\\t\"");
+  REQUIRE(cxx::to_string(std::string("\0\x01\x1f", 3)) == "\"\\u0000\\u0001\\u001f\"");
+  REQUIRE(cxx::to_string("\x7f za\xc5\xbc\xc3\xb3\xc5\x82\xc4\x87") ==
+          "\"\x7f za\xc5\xbc\xc3\xb3\xc5\x82\xc4\x87\"");
+  REQUIRE(cxx::to_string({"lorem\n"_key >> 1}) == "{\"lorem\\n\": 1}");
+}
+
+TEST_CASE("escaping finds special characters at any position of long strings")
+{
+  std::string const clean(100, 'x');
+  for (std::size_t i = 0; i < std::size(clean); ++i)
+  {
+    for (auto const c : {'"', '\\', '\n', '\x01'})
+    {
+      auto str = clean;
+      str[i] = c;
+      auto const text = cxx::to_string(str);
+      REQUIRE(std::size(text) == std::size(str) + ((c == '\x01') ? 7 : 3));
+      REQUIRE(cxx::parse(text) == str);
+    }
+  }
+}
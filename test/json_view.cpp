@@ -0,0 +1,65 @@
+#include "inc/cxx/cbor.hpp"
+#include "inc/cxx/msgpack.hpp"
+#include "inc/cxx/json_view.hpp"
+#include "test/catch.hpp"
+#include "test/utils.hpp"
+
+using namespace cxx::literals;
+using namespace test::literals;
+
+namespace
+{
+  cxx::json const document = {
+      "lorem"_key >> cxx::json{1, -2.5, "ipsum", cxx::json::null, true, cxx::json::array{}},
+      "dolor"_key >> cxx::json{"sit"_key >> cxx::json::byte_stream{cxx::byte{0x2a}},
+                               "amet"_key >> cxx::json{"consectetur"_key >> false}},
+      "adipiscing"_key >> std::numeric_limits<std::int64_t>::min(),
+      "elit"_key >> cxx::json::dictionary{}};
+
+  template <typename T>
+  bool borrowed(T const& x, cxx::json::byte_stream const& bytes)
+  {
+    auto const* const first = reinterpret_cast<char const*>(bytes.data());
+    auto const* const data = reinterpret_cast<char const*>(x.data());
+    return first <= data && data + std::size(x) <= first + std::size(bytes);
+  }
+} // namespace
+
+TEST_CASE("cbor can borrow strings from its input")
+{
+  auto const bytes = cxx::cbor::encode(document);
+  auto const view = cxx::cbor::decode_view(bytes);
+  REQUIRE(view.to_owned() == cxx::cbor::decode(bytes));
+  REQUIRE(cxx::get<std::string_view>(view["lorem"][2]) == "ipsum");
+  REQUIRE(borrowed(cxx::get<std::string_view>(view["lorem"][2]), bytes));
+  REQUIRE(borrowed(cxx::get<cxx::json::byte_view>(view["dolor"]["sit"]), bytes));
+  for (auto const& [key, value] : cxx::get<cxx::json_view::dictionary>(view))
+    REQUIRE(borrowed(key, bytes));
+  REQUIRE(std::size(view["dolor"]["sit"]) == 1);
+  REQUIRE(std::empty(view["elit"]));
+  REQUIRE_THROWS_AS(view["sed"], std::out_of_range);
+  REQUIRE_THROWS_AS(view[0], std::bad_variant_access);
+}
+
+TEST_CASE("msgpack can borrow strings from its input")
+{
+  auto const bytes = cxx::msgpack::encode(document);
+  auto const view = cxx::msgpack::decode_view(bytes);
+  REQUIRE(view.to_owned() == cxx::msgpack::decode(bytes));
+  REQUIRE(borrowed(cxx::get<std::string_view>(view["lorem"][2]), bytes));
+  REQUIRE(borrowed(cxx::get<cxx::json::byte_view>(view["dolor"]["sit"]), bytes));
+  for (auto const& [key, value] : cxx::get<cxx::json_view::dictionary>(view))
+    REQUIRE(borrowed(key, bytes));
+}
+
+TEST_CASE("cbor can not borrow indefinite-length strings")
+{
+  auto const text = "7f61616162ff"_hex;
+  auto const bytes = "5f41014102ff"_hex;
+  auto const key = "a17f61616162ff01"_hex;
+  REQUIRE_THROWS_AS(cxx::cbor::decode_view(text), cxx::cbor::unsupported);
+  REQUIRE_THROWS_AS(cxx::cbor::decode_view(bytes), cxx::cbor::unsupported);
+  REQUIRE_THROWS_AS(cxx::cbor::decode_view(key), cxx::cbor::unsupported);
+  auto const array = "9f61616162ff"_hex;
+  REQUIRE(cxx::cbor::decode_view(array).to_owned() == cxx::json{"a", "b"});
+}
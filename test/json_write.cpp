@@ -0,0 +1,81 @@
+#include "inc/cxx/json.hpp"
+#include "test/catch.hpp"
+#include "test/utils.hpp"
+#include <cstdio>
+#include <sstream>
+#include <unistd.h>
+
+using namespace cxx::literals;
+
+namespace
+{
+  cxx::json const document = {"lorem"_key >> cxx::json{1, 2.5, cxx::json::array()},
+                              "ipsum"_key >> cxx::json{"dolor"_key >> true},
+                              "sit"_key >> cxx::json::dictionary()};
+
+  auto const read_all = [](int fd) {
+    std::string ret;
+    char buffer[0x1000];
+    for (ssize_t n; (n = ::read(fd, buffer, sizeof(buffer))) > 0;)
+      ret.append(buffer, static_cast<std::size_t>(n));
+    return ret;
+  };
+} // namespace
+
+TEST_CASE("to_string supports compact layout")
+{
+  REQUIRE(cxx::to_string(document, cxx::layout{true}) ==
+          R"({"ipsum":{"dolor":true},"lorem":[1,2.5,[]],"sit":{}})");
+  REQUIRE(cxx::to_string(42, cxx::layout{true}) == "42");
+}
+
+TEST_CASE("to_string supports indented layout")
+{
+  REQUIRE(cxx::to_string(document, cxx::layout{false, 2}) == R"({
+  "ipsum": {
+    "dolor": true
+  },
+  "lorem": [
+    1,
+    2.5,
+    []
+  ],
+  "sit": {}
+})");
+  REQUIRE(cxx::to_string({1, cxx::json{"lorem"_key >> 2}}, cxx::layout{true, 1}) ==
+          "[\n 1,\n {\n  \"lorem\":2\n }\n]");
+  REQUIRE(cxx::parse(cxx::to_string(document, cxx::layout{false, 4})) == document);
+}
+
+TEST_CASE("can write json to std::ostream")
+{
+  std::ostringstream os;
+  cxx::write(document, os);
+  REQUIRE(os.str() == cxx::to_string(document));
+  SECTION("with layout")
+  {
+    std::ostringstream indented;
+    cxx::write(document, indented, cxx::layout{false, 2});
+    REQUIRE(indented.str() == cxx::to_string(document, cxx::layout{false, 2}));
+  }
+  SECTION("larger than internal buffer")
+  {
+    cxx::json const large = {std::string(0x20000, 'x'), cxx::json::array(0x10000, 42)};
+    std::ostringstream out;
+    cxx::write(large, out);
+    REQUIRE(out.str() == cxx::to_string(large));
+  }
+}
+
+TEST_CASE("can write json to file descriptor")
+{
+  auto* file = std::tmpfile();
+  REQUIRE(file != nullptr);
+  auto const fd = ::fileno(file);
+  cxx::json const large = cxx::json::array(0x10000, document);
+  cxx::write(large, fd, cxx::layout{true});
+  REQUIRE(::lseek(fd, 0, SEEK_SET) == 0);
+  REQUIRE(read_all(fd) == cxx::to_string(large, cxx::layout{true}));
+  std::fclose(file);
+  REQUIRE_THROWS_AS(cxx::write(document, -1), std::system_error);
+}
@@ -0,0 +1,74 @@
+#include "inc/cxx/cbor.hpp"
+#include "inc/cxx/lazy.hpp"
+#include "inc/cxx/msgpack.hpp"
+#include "test/catch.hpp"
+#include "test/utils.hpp"
+
+using namespace cxx::literals;
+using namespace test::literals;
+
+namespace
+{
+  cxx::json const document = {
+      "lorem"_key >> cxx::json{1, -2.5, "ipsum", cxx::json::null, true, cxx::json::array{}},
+      "dolor"_key >> cxx::json{"sit"_key >> cxx::json::byte_stream{cxx::byte{0x2a}},
+                               "amet"_key >> cxx::json{"consectetur"_key >> false}},
+      "adipiscing"_key >> std::numeric_limits<std::int64_t>::min(),
+      "elit"_key >> cxx::json::dictionary{}};
+
+  template <typename Codec>
+  void lookups()
+  {
+    auto const bytes = Codec::encode(document);
+    auto const doc = Codec::decode_lazy(bytes);
+    REQUIRE(cxx::holds_alternative<cxx::json::dictionary>(doc));
+    REQUIRE(std::size(doc) == 4);
+    REQUIRE(cxx::get<std::int64_t>(doc["adipiscing"]) == std::numeric_limits<std::int64_t>::min());
+    REQUIRE_FALSE(cxx::get<bool>(doc["dolor"]["amet"]["consectetur"]));
+    REQUIRE(cxx::get<std::string>(doc["lorem"][2]) == "ipsum");
+    REQUIRE(cxx::holds_alternative<cxx::json::null_t>(doc["lorem"][3]));
+    REQUIRE_FALSE(cxx::holds_alternative<std::int64_t>(doc["lorem"]));
+    REQUIRE(std::size(doc["lorem"]) == 6);
+    REQUIRE(std::empty(doc["lorem"][5]));
+    REQUIRE(std::empty(doc["elit"]));
+    REQUIRE(doc["dolor"].decoded() == document["dolor"]);
+    REQUIRE(doc.decoded() == document);
+    auto const slice = Codec::encode(document["lorem"]);
+    REQUIRE(doc["lorem"].encoded() == cxx::json::byte_view(slice.data(), std::size(slice)));
+    REQUIRE_THROWS_AS(doc["sed"], std::out_of_range);
+    REQUIRE_THROWS_AS(doc["lorem"][6], std::out_of_range);
+    REQUIRE_THROWS_AS(doc[0], std::bad_variant_access);
+    REQUIRE_THROWS_AS(doc["adipiscing"]["sed"], std::bad_variant_access);
+    REQUIRE_THROWS_AS(cxx::get<double>(doc["lorem"][0]), std::bad_variant_access);
+  }
+} // namespace
+
+TEST_CASE("cbor can decode lazily")
+{
+  lookups<cxx::cbor>();
+  SECTION("with indefinite length items")
+  {
+    auto const bytes = "bf7f61616162ff9f01ff6163a0ff"_hex;
+    auto const doc = cxx::cbor::decode_lazy(bytes);
+    REQUIRE(cxx::get<std::int64_t>(doc["ab"][0]) == 1);
+    REQUIRE(std::empty(doc["c"]));
+  }
+}
+
+TEST_CASE("msgpack can decode lazily")
+{
+  lookups<cxx::msgpack>();
+}
+
+TEST_CASE("lazy decoding consumes only the first node")
+{
+  auto const bytes = "820161616161a0"_hex;
+  cxx::json::byte_view data(bytes.data(), std::size(bytes));
+  auto const doc = cxx::cbor::decode_lazy(cxx::by_ref(data));
+  REQUIRE(std::size(doc.encoded()) == 4);
+  REQUIRE(std::size(data) == 3);
+  REQUIRE(doc.decoded() == cxx::json{1, "a"});
+  REQUIRE(cxx::get<std::string>(cxx::cbor::decode_lazy(cxx::by_ref(data))) == "a");
+  REQUIRE(std::empty(cxx::cbor::decode_lazy(cxx::by_ref(data))));
+  REQUIRE(std::empty(data));
+}
@@ -0,0 +1,67 @@
+#include "inc/cxx/persistent.hpp"
+#include "test/catch.hpp"
+
+using namespace cxx::literals;
+
+namespace
+{
+  cxx::json const config = {
+      "server"_key >> cxx::json{"host"_key >> "localhost", "ports"_key >> cxx::json{80, 443}},
+      "workers"_key >> 4,
+      "debug"_key >> false,
+      "blob"_key >> cxx::json::byte_stream{cxx::byte{0x2a}},
+      "ratio"_key >> 0.5,
+      "parent"_key >> cxx::json::null};
+} // namespace
+
+TEST_CASE("cxx::persistent converts from and to cxx::json")
+{
+  cxx::persistent const x(config);
+  REQUIRE(x.to_json() == config);
+  REQUIRE(std::size(x) == 6);
+  REQUIRE(cxx::get<std::string>(x["server"]["host"]) == "localhost");
+  REQUIRE(cxx::get<std::int64_t>(x["server"]["ports"][1]) == 443);
+  REQUIRE(cxx::holds_alternative<cxx::persistent::null_t>(x["parent"]));
+  REQUIRE(std::empty(x["parent"]));
+  REQUIRE_THROWS_AS(x["missing"], std::out_of_range);
+  REQUIRE_THROWS_AS(x[0], std::bad_variant_access);
+  REQUIRE_THROWS_AS(x["server"]["ports"][2], std::out_of_range);
+}
+
+TEST_CASE("cxx::persistent copies share their content")
+{
+  cxx::persistent const x(config);
+  auto const copy = x;
+  REQUIRE(&cxx::to_object(copy) == &cxx::to_object(x));
+  REQUIRE(copy == x);
+  REQUIRE(cxx::persistent(config) == x);
+  REQUIRE(cxx::persistent() == cxx::persistent::null);
+}
+
+TEST_CASE("cxx::persistent updates copy only the modified path")
+{
+  cxx::persistent const x(config);
+  auto const server = x["server"].with("host", "example.com");
+  auto const y = x.with("server", server).with("workers", 8);
+  REQUIRE(cxx::get<std::string>(x["server"]["host"]) == "localhost");
+  REQUIRE(cxx::get<std::string>(y["server"]["host"]) == "example.com");
+  REQUIRE(cxx::get<std::int64_t>(x["workers"]) == 4);
+  REQUIRE(cxx::get<std::int64_t>(y["workers"]) == 8);
+  REQUIRE(&cxx::to_object(y["server"]["ports"]) == &cxx::to_object(x["server"]["ports"]));
+  REQUIRE(&cxx::to_object(y["blob"]) == &cxx::to_object(x["blob"]));
+  REQUIRE(x != y);
+  SECTION("arrays")
+  {
+    auto const ports = x["server"]["ports"].with(0, 8080).with_appended(8443);
+    REQUIRE(ports.to_json() == cxx::json{8080, 443, 8443});
+    REQUIRE(x["server"]["ports"].to_json() == cxx::json{80, 443});
+    REQUIRE_THROWS_AS(ports.with(3, 0), std::out_of_range);
+  }
+  SECTION("removal")
+  {
+    auto const z = x.without("debug").without("missing");
+    REQUIRE(std::size(z) == 5);
+    REQUIRE(std::size(x) == 6);
+    REQUIRE_THROWS_AS(x["workers"].without("debug"), std::bad_variant_access);
+  }
+}
@@ -0,0 +1,99 @@
+#include "inc/cxx/cbor.hpp"
+#include "inc/cxx/msgpack.hpp"
+#include "inc/cxx/pool.hpp"
+#include "test/catch.hpp"
+#include <thread>
+
+using namespace cxx::literals;
+
+namespace
+{
+  cxx::json const document = {
+      "lorem"_key >> cxx::json{1, -2.5, "ipsum dolor sit amet, consectetur adipiscing elit",
+                               cxx::json::null, true},
+      "sed"_key >> cxx::json{"do"_key >> cxx::json::byte_stream{cxx::byte{0x2a}},
+                             "eiusmod tempor incididunt ut labore"_key >> "et dolore magna"}};
+
+  template <typename Codec>
+  void recycles()
+  {
+    cxx::pool pool;
+    auto const bytes = Codec::encode(document);
+    REQUIRE(Codec::encode(Codec::decode(bytes, &pool)) == bytes);
+    auto const misses = pool.misses();
+    REQUIRE(misses > 0);
+    REQUIRE(pool.hits() == 0);
+    for (int i = 0; i < 3; ++i)
+    {
+      auto const json = Codec::decode(bytes, &pool);
+      REQUIRE(Codec::encode(json) == bytes);
+      REQUIRE(cxx::get<cxx::pmr::json::dictionary>(json).get_allocator().resource() == &pool);
+    }
+    REQUIRE(pool.misses() == misses);
+    REQUIRE(pool.hits() == 3 * misses);
+  }
+} // namespace
+
+TEST_CASE("cxx::pool reuses freed blocks of the same size class")
+{
+  cxx::pool pool;
+  auto* a = pool.allocate(24, 8);
+  pool.deallocate(a, 24, 8);
+  auto* b = pool.allocate(32, 16);
+  REQUIRE(a == b);
+  REQUIRE(pool.hits() == 1);
+  REQUIRE(pool.misses() == 1);
+  auto* c = pool.allocate(33, 16);
+  REQUIRE(c != b);
+  REQUIRE(pool.misses() == 2);
+  pool.deallocate(b, 32, 16);
+  pool.deallocate(c, 33, 16);
+  SECTION("large and over-aligned blocks bypass the free lists")
+  {
+    auto* large = pool.allocate(cxx::pool::max_block_size + 1, 8);
+    pool.deallocate(large, cxx::pool::max_block_size + 1, 8);
+    auto* aligned = pool.allocate(64, 64);
+    pool.deallocate(aligned, 64, 64);
+    REQUIRE(pool.misses() == 4);
+    REQUIRE(pool.hits() == 1);
+  }
+  SECTION("release empties the free lists")
+  {
+    pool.release();
+    pool.deallocate(pool.allocate(24, 8), 24, 8);
+    REQUIRE(pool.misses() == 3);
+  }
+}
+
+TEST_CASE("cxx::pool caches a bounded number of blocks")
+{
+  cxx::pool pool(1);
+  auto* a = pool.allocate(16, 8);
+  auto* b = pool.allocate(16, 8);
+  pool.deallocate(a, 16, 8);
+  pool.deallocate(b, 16, 8);
+  REQUIRE(pool.allocate(16, 8) == a);
+  auto* c = pool.allocate(16, 8);
+  REQUIRE(pool.misses() == 3);
+  pool.deallocate(a, 16, 8);
+  pool.deallocate(c, 16, 8);
+}
+
+TEST_CASE("cxx::pool::local is per thread")
+{
+  auto* main = &cxx::pool::local();
+  REQUIRE(main == &cxx::pool::local());
+  cxx::pool* other = nullptr;
+  std::thread([&] { other = &cxx::pool::local(); }).join();
+  REQUIRE(other != main);
+}
+
+TEST_CASE("cxx::cbor decodes into recycled memory")
+{
+  recycles<cxx::cbor>();
+}
+
+TEST_CASE("cxx::msgpack decodes into recycled memory")
+{
+  recycles<cxx::msgpack>();
+}
@@ -0,0 +1,82 @@
+#include "inc/cxx/reclaimer.hpp"
+#include "test/catch.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  std::atomic<std::int64_t> allocated{0};
+
+  cxx::json document(std::int64_t i)
+  {
+    return cxx::json::dictionary{{"id", i}, {"tags", cxx::json{"lorem", cxx::json{i, "ipsum"}}}};
+  }
+} // namespace
+
+void* operator new(std::size_t size)
+{
+  ++allocated;
+  if (auto* ptr = std::malloc(size)) return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+  if (ptr) --allocated;
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  ::operator delete(ptr);
+}
+
+TEST_CASE("cxx::reclaimer takes ownership of deferred documents")
+{
+  cxx::reclaimer reclaimer;
+  auto x = document(42);
+  reclaimer.defer(std::move(x));
+  REQUIRE(cxx::holds_alternative<cxx::json::null_t>(x));
+  reclaimer.drain();
+  reclaimer.defer(document(43));
+  reclaimer.drain();
+}
+
+TEST_CASE("cxx::reclaimer blocks producers while its queue is full")
+{
+  cxx::reclaimer reclaimer(2);
+  std::atomic<std::int64_t> deferred{0};
+  std::vector<std::thread> producers;
+  for (int i = 0; i < 4; ++i)
+    producers.emplace_back([&] {
+      for (std::int64_t k = 0; k < 1000; ++k)
+      {
+        reclaimer.defer(document(k));
+        ++deferred;
+      }
+    });
+  for (auto& x : producers) x.join();
+  reclaimer.drain();
+  REQUIRE(deferred == 4000);
+}
+
+TEST_CASE("cxx::reclaimer frees pending documents on destruction")
+{
+  auto const before = allocated.load();
+  {
+    cxx::reclaimer reclaimer(1000);
+    for (std::int64_t k = 0; k < 1000; ++k) reclaimer.defer(document(k));
+  }
+  auto const after = allocated.load();
+  REQUIRE(after == before);
+}
+
+TEST_CASE("cxx::defer_destroy frees on a shared reclaimer")
+{
+  auto x = document(1);
+  cxx::defer_destroy(std::move(x));
+  REQUIRE(cxx::holds_alternative<cxx::json::null_t>(x));
+}
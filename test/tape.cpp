@@ -0,0 +1,95 @@
+#include "inc/cxx/cbor.hpp"
+#include "inc/cxx/msgpack.hpp"
+#include "inc/cxx/tape.hpp"
+#include "test/catch.hpp"
+#include "test/utils.hpp"
+
+using namespace cxx::literals;
+using namespace test::literals;
+
+namespace
+{
+  cxx::json const document = {
+      "lorem"_key >> cxx::json{1, -2.5, "ipsum", cxx::json::null, true, cxx::json::array{}},
+      "dolor"_key >> cxx::json{"sit"_key >> cxx::json::byte_stream{cxx::byte{0x2a}},
+                               "amet"_key >> cxx::json{"consectetur"_key >> false}},
+      "adipiscing"_key >> std::numeric_limits<std::int64_t>::min(),
+      "elit"_key >> cxx::json::dictionary{}};
+
+  bool same(cxx::tape::value x, cxx::json const& y);
+
+  auto const compare = [](cxx::json const& y) {
+    return cxx::overload{
+        [&y](cxx::tape::dictionary x) {
+          auto const& dict = cxx::get<cxx::json::dictionary>(y);
+          if (std::size(x) != std::size(dict)) return false;
+          for (auto const [key, value] : x)
+            if (!same(value, dict.at(key))) return false;
+          return true;
+        },
+        [&y](cxx::tape::array x) {
+          auto const& array = cxx::get<cxx::json::array>(y);
+          if (std::size(x) != std::size(array)) return false;
+          auto it = std::begin(array);
+          for (auto const value : x)
+            if (!same(value, *it++)) return false;
+          return true;
+        },
+        [&y](std::string_view x) { return x == cxx::get<std::string>(y); },
+        [&y](cxx::tape::byte_view x) {
+          auto const& bytes = cxx::get<cxx::json::byte_stream>(y);
+          return x == cxx::tape::byte_view(bytes.data(), std::size(bytes));
+        },
+        [&y](auto x) { return y == x; }};
+  };
+
+  bool same(cxx::tape::value x, cxx::json const& y)
+  {
+    return static_cast<std::size_t>(x.type()) == cxx::to_object(y).index() &&
+           std::size(x) == std::size(y) && cxx::visit(compare(y), x);
+  }
+} // namespace
+
+TEST_CASE("cbor can decode a tape")
+{
+  auto const bytes = cxx::cbor::encode(document);
+  auto const doc = cxx::cbor::decode_tape(bytes);
+  REQUIRE(same(doc.root(), cxx::cbor::decode(bytes)));
+  SECTION("with indefinite length items")
+  {
+    auto const tape = cxx::cbor::decode_tape("9f5f42010243030405ff7f62617a6162ffbf616101ffff"_hex);
+    auto const root = tape.root();
+    REQUIRE(std::size(root) == 3);
+    auto const chunks = "0102030405"_hex;
+    REQUIRE(cxx::get<cxx::tape::byte_view>(root[0]) ==
+            cxx::tape::byte_view(chunks.data(), std::size(chunks)));
+    REQUIRE(cxx::get<std::string_view>(root[1]) == "azb");
+    REQUIRE(cxx::get<std::int64_t>(root[2]["a"]) == 1);
+  }
+}
+
+TEST_CASE("msgpack can decode a tape")
+{
+  auto const bytes = cxx::msgpack::encode(document);
+  auto const doc = cxx::msgpack::decode_tape(bytes);
+  REQUIRE(same(doc.root(), cxx::msgpack::decode(bytes)));
+}
+
+TEST_CASE("cxx::tape skips over subtrees")
+{
+  auto const doc = cxx::msgpack::decode_tape(cxx::msgpack::encode(document));
+  auto const root = doc.root();
+  REQUIRE(cxx::holds_alternative<cxx::tape::dictionary>(root));
+  REQUIRE(cxx::get<std::int64_t>(root["adipiscing"]) == std::numeric_limits<std::int64_t>::min());
+  REQUIRE(cxx::get<bool>(root["dolor"]["amet"]["consectetur"]) == false);
+  REQUIRE(cxx::get<double>(root["lorem"][1]) == -2.5);
+  REQUIRE(cxx::holds_alternative<cxx::tape::null_t>(root["lorem"][3]));
+  REQUIRE(std::empty(root["lorem"][5]));
+  REQUIRE(std::empty(root["elit"]));
+  REQUIRE(cxx::get<cxx::tape::dictionary>(root).contains("elit"));
+  REQUIRE_FALSE(cxx::get<cxx::tape::dictionary>(root).contains("sed"));
+  REQUIRE_THROWS_AS(root["sed"], std::out_of_range);
+  REQUIRE_THROWS_AS(root["lorem"][6], std::out_of_range);
+  REQUIRE_THROWS_AS(root[0], std::bad_variant_access);
+  REQUIRE_THROWS_AS(cxx::get<double>(root["lorem"][0]), std::bad_variant_access);
+}
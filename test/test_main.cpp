@@ -1,4 +1,5 @@
 #define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_NO_POSIX_SIGNALS
 #include "test/catch_wrap.hpp"
 
 auto ::Catch::StringMaker<::cxx::json::byte_stream>::convert(::cxx::json::byte_stream const& bytes)